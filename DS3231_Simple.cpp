@@ -1,13 +1,173 @@
 #include <DS3231_Simple.h>
 
-void DS3231_Simple::begin()
+// ESP8266 and ESP32 need interrupt handlers to be in RAM
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+
+// The buses (and EEPROM address) are fixed when compiled, unless they can be chosen with setWire()
+#ifdef USE_SELECTABLE_WIRE
+#define RTC_BUS       (*rtcWire)
+#define EEPROM_BUS    (*eepromWire)
+#define EEPROM_DEVICE eepromAddress
+#else
+#define RTC_BUS       DS3231_WIRE
+#define EEPROM_BUS    DS3231_EEPROM_WIRE
+#define EEPROM_DEVICE EEPROM_ADDRESS
+#endif
+
+static inline uint8_t isSameWire(const TwoWire &A, const TwoWire &B)
+{
+  return &A == &B;
+}
+
+#ifdef USE_STATISTICS
+// Passes everything on to the bus, counting the traffic against the call in progress
+class DS3231_CountingWire
+{
+  public:
+    DS3231_CountingWire(TwoWire &Bus, DS3231_Simple::Statistics &Stats) 
+      : bus(Bus), api(Stats.Api[Stats.Current < DS3231_Simple::STATS_APIS ? Stats.Current : DS3231_Simple::STATS_OTHER]) { }
+    
+    void    begin()                                        { bus.begin(); }
+    void    beginTransmission(const uint8_t Address)       { bus.beginTransmission(Address); }
+    int     read()                                         { return bus.read(); }
+    
+    size_t  write(const uint8_t Data)
+    {
+      api.Bytes++;
+      return bus.write(Data);
+    }
+    
+    size_t  write(const uint8_t *Data, const size_t Length)
+    {
+      api.Bytes += Length;
+      return bus.write(Data, Length);
+    }
+    
+    uint8_t endTransmission(const uint8_t Stop = true)
+    {
+      uint8_t Result = bus.endTransmission(Stop);
+      
+      api.Transactions++;
+      if(Result) api.Nacks++;
+      return Result;
+    }
+    
+    uint8_t requestFrom(const uint8_t Address, const uint8_t Quantity)
+    {
+      uint8_t Received = bus.requestFrom(Address, Quantity);
+      
+      api.Transactions++;
+      api.Bytes += Received;
+      if(Received != Quantity) api.Nacks++;
+      return Received;
+    }
+    
+  protected:
+    TwoWire                        &bus;
+    DS3231_Simple::ApiStatistics   &api;
+};
+
+// Counts a call to the API, and how long it took, unless it is part of another call
+class DS3231_CountingScope
+{
+  public:
+    DS3231_CountingScope(DS3231_Simple::Statistics &Stats, const uint8_t Api) 
+      : stats(Stats), counting(Stats.Current == DS3231_Simple::STATS_NONE), started(micros())
+    {
+      if(counting) stats.Current = Api;
+    }
+    
+    ~DS3231_CountingScope()
+    {
+      if(!counting) return;
+      
+      unsigned long Took   = micros() - started;
+      uint8_t       Bucket = 0;
+      
+      // 250uS, then 4 times as long for each bucket
+      for(unsigned long Limit = 250; Took >= Limit && Bucket < DS3231_Simple::STATS_LATENCY_BUCKETS - 1; Limit *= 4) Bucket++;
+      
+      DS3231_Simple::ApiStatistics &api = stats.Api[stats.Current];
+      api.Calls++;
+      if(api.Latency[Bucket] < 0xFFFF) api.Latency[Bucket]++;
+      
+      stats.Current = DS3231_Simple::STATS_NONE;
+    }
+    
+  protected:
+    DS3231_Simple::Statistics      &stats;
+    uint8_t                         counting;
+    unsigned long                   started;
+};
+
+#define RTC_WIRE            DS3231_CountingWire(RTC_BUS, statistics)
+#define EEPROM_WIRE         DS3231_CountingWire(EEPROM_BUS, statistics)
+#define COUNT_CALL(Api)     DS3231_CountingScope CountingScope(statistics, Api)
+#define COUNT_POLL()        statistics.Api[statistics.Current < STATS_APIS ? statistics.Current : STATS_OTHER].Polls++
+#define COUNT_RETRY()       statistics.Api[statistics.Current < STATS_APIS ? statistics.Current : STATS_OTHER].Retries++
+#else
+#define RTC_WIRE            RTC_BUS
+#define EEPROM_WIRE         EEPROM_BUS
+#define COUNT_CALL(Api)
+#define COUNT_POLL()
+#define COUNT_RETRY()
+#endif
+
+DS3231_Simple *DS3231_Simple::tickClock = NULL;
+
+#ifdef USE_SELECTABLE_WIRE
+void DS3231_Simple::setWire(TwoWire &RtcWire, TwoWire &EepromWire, const uint8_t EepromAddress)
+{
+  rtcWire       = &RtcWire;
+  eepromWire    = &EepromWire;
+  eepromAddress = EepromAddress;
+  
+  // Nothing we know about the registers of another clock
+  registerShadowValid = 0;
+}
+#endif
+
+uint8_t DS3231_Simple::begin(const uint8_t Mode)
 {  
-  Wire.begin();
+  COUNT_CALL(STATS_OTHER);
+  uint8_t statusByte;
+  
+  RTC_WIRE.begin();
+  if(!isSameWire(EEPROM_BUS, RTC_BUS)) EEPROM_WIRE.begin();
+  
+  if(Mode == BEGIN_WARM)
+  {
+    // Alarms, Control and Status, 0x07 to 0x0F
+    registerShadowValid = 0;
+    if(rtc_i2c_read(0x07, sizeof(registerShadow) + 1))
+    {
+      for(uint8_t x = 0; x < sizeof(registerShadow); x++) registerShadow[x] = RTC_WIRE.read();
+      registerShadow[0xE - 0x7] &= ~_BV(5); // CONV clears itself
+      registerShadowValid = 1;
+      
+      statusByte = RTC_WIRE.read();
+      
+      // Oscillator Stop Flag clear, the clock has kept going since it was set up
+      if(!(statusByte & _BV(7)))
+      {
+        squareWaveRate = (registerShadow[0xE - 0x7] & _BV(2)) ? SQW_OFF : (registerShadow[0xE - 0x7] & 0B00011000);
+        
+        // EOSC set stops the oscillator when on battery, we want it always on
+        writeRegister(0xE, registerShadow[0xE - 0x7] & ~_BV(7));
+        return 1;
+      }
+    }
+  }
    
   // Setup the clock to make sure that it is running, that the oscillator and 
   // square wave are disabled, and that alarm interrupts are disabled
-  rtc_i2c_write_byte(0xE, 0b00000000);
-  disableAlarms();
+  registerShadowValid = 0;
+  squareWaveRate = SQW_OFF;
+  if(!writeRegister(0xE, 0b00000100) || !disableAlarms()) return 0;
+  
+  return Mode == BEGIN_WARM ? 0 : 1;
 }
 
 // Page 11 of Datasheet shows that the LSB 4 bits of the data types are always the last BCD digit
@@ -22,52 +182,121 @@ void DS3231_Simple::print_zero_padded(Stream &Printer, uint8_t x)
   Printer.print(x);
 }
 
-uint8_t DS3231_Simple::rtc_i2c_seek(const uint8_t Address)
+uint8_t DS3231_Simple::recoverBus(const uint8_t SdaPin, const uint8_t SclPin)
 {
-  Wire.beginTransmission(RTC_ADDRESS);
-  Wire.write(Address);
-  return Wire.endTransmission();
+#if DS3231_WIRE_HAS_END
+  // While the I2C hardware has the pins, pinMode() and digitalWrite() don't reach the bus
+  RTC_BUS.end();
+  if(!isSameWire(EEPROM_BUS, RTC_BUS)) EEPROM_BUS.end();
+#endif
+  
+  // Let go of the pins, the pullups will take them high unless something holds them
+  pinMode(SdaPin, INPUT_PULLUP);
+  pinMode(SclPin, INPUT_PULLUP);
+  delayMicroseconds(10);
+  
+  // A device stuck part way through sending a byte lets go of SDA within 9 clocks
+  for(uint8_t x = 0; x < 9 && !digitalRead(SdaPin); x++)
+  {
+    pinMode(SclPin, OUTPUT);
+    digitalWrite(SclPin, LOW);
+    delayMicroseconds(5);
+    pinMode(SclPin, INPUT_PULLUP);
+    delayMicroseconds(5);
+  }
+  
+  uint8_t Free = digitalRead(SdaPin);
+  
+  // STOP, SDA going high while SCL is high
+  pinMode(SdaPin, OUTPUT);
+  digitalWrite(SdaPin, LOW);
+  delayMicroseconds(5);
+  pinMode(SdaPin, INPUT_PULLUP);
+  delayMicroseconds(5);
+  
+  RTC_BUS.begin();
+  if(!isSameWire(EEPROM_BUS, RTC_BUS)) EEPROM_BUS.begin();
+  
+  // Who knows what the registers have now
+  registerShadowValid = 0;
+  return Free;
 }
 
-uint8_t DS3231_Simple::rtc_i2c_write_byte(const uint8_t Address, const uint8_t Data)
+uint8_t DS3231_Simple::retryI2C(const uint8_t Error, uint8_t &Attempt)
 {
-  Wire.beginTransmission(RTC_ADDRESS);
-  Wire.write(Address);
-  Wire.write(Data);
-  return Wire.endTransmission();
+  if(Attempt + 1 > DS3231_I2C_RETRIES)
+  {
+    lastError = Error;
+    return 0;
+  }
+  
+  // Give whatever upset it a moment, longer each time
+  delayMicroseconds((unsigned int) DS3231_I2C_RETRY_DELAY << Attempt);
+  Attempt++;
+  COUNT_RETRY();
+  return 1;
 }
 
-uint8_t DS3231_Simple::rtc_i2c_read_byte(const uint8_t Address, uint8_t &Data)
+uint8_t DS3231_Simple::rtc_i2c_read(const uint8_t Address, const uint8_t Count)
 {
-  rtc_i2c_seek(Address);
-  #if 0
-  // hardware/arduino/avr/libraries/Wire/utilities/twi.cpp::twi_readFrom()
-  // returns 0 ONLy if the buffer is too small for the number of bytes we
-  // want.  Since we are reading 1 byte, that's never going to happen
-  // so there is no point in this comparison.  
-  //
-  // Short Version: Wire.requestFrom(x, n) can only ever return n
-  //
-  // Leaving this here in case twi.cpp changes in the future to return 
-  // 0 on other cases.
+  uint8_t Attempt = 0;
+  uint8_t Error;
   
-  if(Wire.requestFrom(RTC_ADDRESS,(uint8_t) 1) == 1)
+  do
   {
-    Data = Wire.read();
-    return 1;
-  }
+    // Set the register address by doing a write of just the address
+    RTC_WIRE.beginTransmission(RTC_ADDRESS);
+    RTC_WIRE.write(Address);
+    Error = RTC_WIRE.endTransmission();
+    
+    if(!Error)
+    {
+      if(RTC_WIRE.requestFrom(RTC_ADDRESS, Count) == Count) return 1;
+      Error = ERROR_SHORT_READ;
+    }
+  } while(retryI2C(Error, Attempt));
+  
+  return 0;
+}
+
+uint8_t DS3231_Simple::rtc_i2c_write(const uint8_t Address, const uint8_t *Data, const uint8_t Length)
+{
+  uint8_t Attempt = 0;
+  uint8_t Error;
+  
+  do
+  {
+    RTC_WIRE.beginTransmission(RTC_ADDRESS);
+    RTC_WIRE.write(Address);
+    for(uint8_t x = 0; x < Length; x++) RTC_WIRE.write(Data[x]);
+    
+    // endTransmission returns a code in the response, to make it "Simple" we will return 0 for any fail, and 1 for OK
+    Error = RTC_WIRE.endTransmission();
+    if(!Error) return 1;
+  } while(retryI2C(Error, Attempt));
+  
   return 0;
-  #else
-  Wire.requestFrom(RTC_ADDRESS,(uint8_t) 1);
-  Data = Wire.read();
+}
+
+uint8_t DS3231_Simple::rtc_i2c_write_byte(const uint8_t Address, const uint8_t Data)
+{
+  return rtc_i2c_write(Address, &Data, 1);
+}
+
+uint8_t DS3231_Simple::rtc_i2c_read_byte(const uint8_t Address, uint8_t &Data)
+{
+  if(!rtc_i2c_read(Address, 1)) return 0;
+  
+  Data = RTC_WIRE.read();
   return 1;
-  #endif  
 }
 
 // Compare the datetime of two objects to put i ascending date order 
 //  -1 A is befre B, 1 B is before A, 0 identical
 int8_t DS3231_Simple::compareTimestamps(const DateTime &A, const DateTime &B)
 {
+  // Field by field, usually decided in the first field or two, which is much
+  // cheaper on an 8 bit MCU than two toEpoch() (32 bit multiplies).
   if(A.Year < B.Year)       return -1;
   if(A.Year > B.Year)       return  1;
 
@@ -89,51 +318,340 @@ int8_t DS3231_Simple::compareTimestamps(const DateTime &A, const DateTime &B)
   return 0;
 }
 
-uint8_t DS3231_Simple::formatEEPROM()
+uint8_t DS3231_Simple::formatEEPROM(const uint8_t Mode)
 {
-  eepromWriteAddress = 0;
-  writeBytePagewizeStart();
-  for(uint16_t x = 0; x < EEPROM_BYTES; x++)
+  COUNT_CALL(STATS_FORMAT);
+#ifdef USE_ASYNC_LOG
+  flushLog();
+#endif
+  eepromFailed = 0;
+
+#ifdef USE_LOG_SUPERBLOCK
+  if(Mode == FORMAT_LOGICAL)
   {
-    writeBytePagewize(0);
+    // Checkpoint an empty log where the writer is, everything before it is forgotten
+    // and will be wiped as the writer comes around to it.
+    // Nothing is checkpointed unless the writer was found and the space after it cleared,
+    // or the checkpoint could point the reader at the middle of a block.
+    if(!findLogAddresses()) return 0;
+    if(eepromWriteAddress >= EEPROM_LOG_BYTES) eepromWriteAddress = 0;
+    
+    const EEPROMAddress oldEepromReadAddress = eepromReadAddress;
+    if(!makeEEPROMSpace(eepromWriteAddress, 5))
+    {
+      if(eepromFailed) forgetLogAddresses(eepromReadAddress == oldEepromReadAddress ? oldEepromReadAddress : EEPROM_LOG_BYTES);
+      return 0;
+    }
+    eepromReadAddress = eepromWriteAddress;
+    return checkpointLog();
+  }
+#endif
+
+  EEPROMAddress x;
+  
+  if(Mode == FORMAT_FULL)
+  {
+    // Each chunk's write is ended inside writeBytePagewize(), stop at the first that fails
+    eepromWriteAddress = 0;
+    writeBytePagewizeStart();
+    for(x = 0; x < EEPROM_BYTES && !eepromFailed; x++)
+    {
+      writeBytePagewize(0);
+    }
+    if(!eepromFailed) writeBytePagewizeEnd();
+  }
+  else
+  {
+    // Read it all, and only wipe the chunks which are not already blank.
+    EEPROMReadCache cache;
+    cache.Length = 0;
+    
+    // A byte that could not be read is not blank, and nor is anything after it, 
+    // so stop at the first read or write that fails.
+    uint8_t writing = 0;
+    for(EEPROMAddress chunk = 0; chunk < EEPROM_BYTES && !eepromFailed; chunk += EEPROM_WRITE_CHUNK)
+    {
+      for(x = chunk; x < chunk + EEPROM_WRITE_CHUNK && !readEEPROMByte(x, cache) && !eepromFailed; x++);
+      if(eepromFailed) break;
+      
+      if(x < chunk + EEPROM_WRITE_CHUNK)
+      {
+        // Following dirty chunks carry on in the same pagewize write.
+        if(!writing)
+        {
+          eepromWriteAddress = chunk;
+          writeBytePagewizeStart();
+          writing = 1;
+        }
+        for(x = 0; x < EEPROM_WRITE_CHUNK; x++)
+        {
+          writeBytePagewize(0);
+        }
+      }
+      else if(writing)
+      {
+        writeBytePagewizeEnd();
+        writing = 0;
+      }
+    }
+    
+    if(writing && !eepromFailed) writeBytePagewizeEnd();
+  }
+  
+  // Part formatted, the log has to be found again from what is there
+  if(eepromFailed)
+  {
+    forgetLogAddresses(EEPROM_LOG_BYTES);
+    return 0;
   }
-  writeBytePagewizeEnd();
   
   eepromWriteAddress = 0;
   eepromReadAddress  = 0; 
+  
+#ifdef USE_SEQUENCED_LOG
+  eepromWriteSequence = 0;
+#endif
+  
+#ifdef USE_LOG_SUPERBLOCK
+  return checkpointLog();
+#else
   return 1;
+#endif
 }
 
-uint8_t DS3231_Simple::readEEPROMByte(const uint16_t address)
+uint8_t DS3231_Simple::readEEPROMByte(const EEPROMAddress address)
 {
   uint8_t b = 0;
-  Wire.beginTransmission(EEPROM_ADDRESS); // DUMMY WRITE
-  Wire.write((uint8_t) ((address>>8) & 0xFF)); 
-  Wire.write((uint8_t) ((address) & 0xFF)); 
+  readEEPROMBytes(address, &b, 1);  
+  return b;
+}
+
+uint8_t DS3231_Simple::readEEPROMByte(const EEPROMAddress Address, EEPROMReadCache &Cache)
+{
+  if(Address >= EEPROM_BYTES) return 0;
+  
+  // Note the cast, when Address is below the window this wraps to a large number
+  if((EEPROMAddress)(Address - Cache.Address) >= Cache.Length)
+  {
+    Cache.Address = Address;
+    Cache.Length  = (EEPROM_BYTES - Address) < EEPROM_READ_CHUNK ? (EEPROM_BYTES - Address) : EEPROM_READ_CHUNK;
+    if(!readEEPROMBytes(Address, Cache.Data, Cache.Length))
+    {
+      Cache.Length = 0;
+      return 0;
+    }
+  }
+  
+  return Cache.Data[Address - Cache.Address];
+}
+
+uint8_t DS3231_Simple::readEEPROMBytes(EEPROMAddress Address, uint8_t *Buffer, uint16_t Count)
+{
+  uint8_t chunk;
+  uint8_t error;
+  uint8_t attempt = 0;
+  uint8_t seeked  = 0;
+  
+#ifdef USE_ASYNC_LOG
+  uint8_t  *start = Buffer;
+  EEPROMAddress first = Address;
+  uint16_t total  = Count;
+#endif
+  
+  while(Count)
+  {
+    if(!seeked)
+    {
+      EEPROM_WIRE.beginTransmission(EEPROM_DEVICE); // DUMMY WRITE
+      EEPROM_WIRE.write((uint8_t) ((Address>>8) & 0xFF)); 
+      EEPROM_WIRE.write((uint8_t) ((Address) & 0xFF)); 
+      
+      error = EEPROM_WIRE.endTransmission(false); // Do not send STOP, just restart
+      if(error)
+      {
+        if(!retryI2C(error, attempt)) break;
+        continue;
+      }
+      seeked = 1;
+    }
+    
+    chunk = Count > EEPROM_READ_CHUNK ? EEPROM_READ_CHUNK : Count;
+    
+    // The EEPROM keeps incrementing it's internal address as we read, so 
+    // following chunks are just a "current address read", no need to seek again.
+    // Unless that failed, then we don't know where it got to.
+    if(EEPROM_WIRE.requestFrom(EEPROM_DEVICE, chunk) != chunk)
+    {
+      seeked = 0;
+      if(!retryI2C(ERROR_SHORT_READ, attempt)) break;
+      continue;
+    }
+    
+    Count   -= chunk;
+    Address += chunk;
+    while(chunk--)
+    {
+      *Buffer++ = EEPROM_WIRE.read();
+    }
+  }
   
-  if(Wire.endTransmission(false)) // Do not send STOP, just restart
+  if(Count)
   {
+    // The log must not take this for blank EEPROM
+    eepromFailed = 1;
     return 0;
   }
   
-  if(Wire.requestFrom(EEPROM_ADDRESS, (uint8_t) 1))
+#ifdef USE_ASYNC_LOG
+  // Anything still waiting to be written reads as what it will be once it is.
+  for(uint8_t s = 0; s < eepromWriteSlotCount; s++)
+  {
+    const EEPROMWriteSlot &slot = eepromWriteSlots[(eepromWriteSlotHead + s) % LOG_WRITE_SLOTS];
+    for(uint8_t x = 0; x < slot.Length; x++)
+    {
+      // Note the cast, when the slot is below the Address this wraps to a large number
+      if((EEPROMAddress)(slot.Address + x - first) < total) start[slot.Address + x - first] = slot.Data[x];
+    }
+  }
+#endif
+  
+  return 1;
+}
+
+#ifdef USE_SEQUENCED_LOG
+uint16_t DS3231_Simple::sequenceDistance(const uint16_t From, const uint16_t To)
+{
+  // Sequence numbers run 1..65535 and wrap to 1, zero is never used.
+  return ((uint32_t)To + 65535 - From) % 65535;
+}
+
+uint16_t DS3231_Simple::readEEPROMPageSequence(const uint16_t Page)
+{
+  uint8_t b[LOG_PAGE_HEADER] = { 0, 0 };
+  readEEPROMBytes((EEPROMAddress)Page * EEPROM_PAGE_SIZE, b, LOG_PAGE_HEADER);
+  return b[0] | (b[1] << 8);
+}
+
+uint8_t DS3231_Simple::eepromPageHasBlocks(const uint16_t Page, EEPROMReadCache &Cache)
+{
+  for(EEPROMAddress x = (EEPROMAddress)Page * EEPROM_PAGE_SIZE + LOG_PAGE_HEADER; x < (EEPROMAddress)(Page+1) * EEPROM_PAGE_SIZE && !eepromFailed; x++)
+  {
+    if(readEEPROMByte(x, Cache)) return 1;
+  }
+  return 0;
+}
+
+// Locate the NEXT place to store a block
+DS3231_Simple::EEPROMAddress DS3231_Simple::findEEPROMWriteAddress()
+{
+  uint16_t first = readEEPROMPageSequence(0);
+  uint16_t lo = 0, hi = EEPROM_PAGES - 1, mid, seq;
+  
+  eepromWriteSequence = first;
+  if(!first)
+  {
+    // Nothing has been written since format.
+    return eepromWriteAddress = 0;
+  }
+  
+  // The pages written in the current lap of the EEPROM (0 up to the head page) 
+  // carry consecutive sequence numbers starting from the one in page zero, 
+  // any page after the head is either blank or from the previous lap.  So we can
+  // binary search for the head.
+  while(lo < hi && !eepromFailed)
+  {
+    mid = lo + (hi - lo + 1) / 2;
+    seq = readEEPROMPageSequence(mid);
+    if(seq && sequenceDistance(first, seq) == mid)
+    {
+      lo = mid;
+      eepromWriteSequence = seq;
+    }
+    else
+    {
+      hi = mid - 1;
+    }
+  }
+  
+  // Now find the end of the last block in the head page.
+  EEPROMReadCache cache;
+  cache.Length = 0;
+  
+  uint8_t       t;
+  EEPROMAddress x   = (EEPROMAddress)lo * EEPROM_PAGE_SIZE + LOG_PAGE_HEADER;
+  EEPROMAddress end = x - LOG_PAGE_HEADER + EEPROM_PAGE_SIZE;
+  
+  eepromWriteAddress = x;
+  while(x < end && !eepromFailed)
   {
-    b = Wire.read();
+    t = readEEPROMByte(x, cache);
+    if(!t) { x++; continue; } // Already read block, or the free space at the end
+    
+    eepromWriteAddress = x = x + (t >> 5) + 5;
   }
   
-  Wire.endTransmission(); // Now send STOP
+  // A full page means the next block starts the next page
+  if(eepromWriteAddress > end)               eepromWriteAddress = end;
+  if(eepromWriteAddress >= EEPROM_LOG_BYTES)         eepromWriteAddress = 0;
   
-  return b;
+  return eepromWriteAddress;
 }
 
+// Locate the NEXT block to read from
+DS3231_Simple::EEPROMAddress DS3231_Simple::findEEPROMReadAddress()
+{
+  if(eepromWriteAddress >= EEPROM_LOG_BYTES) findEEPROMWriteAddress();
+  
+  EEPROMReadCache cache;
+  cache.Length = 0;
+  
+  // The head page is the one the writer is in, unless the writer is sitting
+  // at the start of a page, in which case it's the one before that.
+  uint16_t head = ((eepromWriteAddress + EEPROM_LOG_BYTES - 1) % EEPROM_LOG_BYTES) / EEPROM_PAGE_SIZE;
+  uint16_t lo = 0, hi = EEPROM_PAGES, mid;
+  
+  // Going around the EEPROM from the oldest page (after the head) to the head, 
+  // blocks are read (zeroed) in order, so there is a run of pages without any 
+  // blocks, then a run of pages with.  Binary search for the first with.
+  while(lo < hi && !eepromFailed)
+  {
+    mid = (lo + hi) / 2;
+    if(eepromPageHasBlocks((head + 1 + mid) % EEPROM_PAGES, cache))
+    {
+      hi = mid;
+    }
+    else
+    {
+      lo = mid + 1;
+    }
+  }
+  
+  if(lo == EEPROM_PAGES)
+  {
+    // Nothing to read, wait at the writer
+    eepromReadAddress = eepromWriteAddress;
+  }
+  else
+  {
+    // readLog() will skip forward to the first block in the page
+    eepromReadAddress = (EEPROMAddress)((head + 1 + lo) % EEPROM_PAGES) * EEPROM_PAGE_SIZE + LOG_PAGE_HEADER;
+  }
+  
+  return eepromReadAddress;
+}
+
+#else
+
 // Locate the NEXT place to store a block
-uint16_t DS3231_Simple::findEEPROMWriteAddress()
+DS3231_Simple::EEPROMAddress DS3231_Simple::findEEPROMWriteAddress()
 {   
   uint8_t t = 0;
+  EEPROMReadCache cache;
+  cache.Length = 0;
   
-  for(eepromWriteAddress = 0; eepromWriteAddress < EEPROM_BYTES; )
+  for(eepromWriteAddress = 0; eepromWriteAddress < EEPROM_LOG_BYTES; )
   {
-    t = readEEPROMByte(eepromWriteAddress);
+    t = readEEPROMByte(eepromWriteAddress, cache);
 
     // If the byte read is a zero, then this is the top of the stack.
     if(t == 0) break;
@@ -149,7 +667,7 @@ uint16_t DS3231_Simple::findEEPROMWriteAddress()
   }
 
   // If we have filled up as much as we can... reset back to the bottom as the stack top.
-  if(eepromWriteAddress >= EEPROM_BYTES-5) 
+  if(eepromWriteAddress >= EEPROM_LOG_BYTES-5) 
   {
     eepromWriteAddress = 0;
   }
@@ -158,25 +676,29 @@ uint16_t DS3231_Simple::findEEPROMWriteAddress()
 }
 
 // Locate the NEXT block to read from
-uint16_t DS3231_Simple::findEEPROMReadAddress()
+DS3231_Simple::EEPROMAddress DS3231_Simple::findEEPROMReadAddress()
 {   
   // This is going to be really memory hungry :-/
   // Anybody care to think of a better way.
-  uint16_t nxtPtr, x      = 0;
+  EEPROMAddress nxtPtr, x = 0;
   
   DateTime currentOldest;
   DateTime compareWith;
   currentOldest.Year = 255; // An invalid year the highest we can go so that any valid log is older.
   
-  // Find the oldest block, that is the bottom
-  for(x = 0; x < EEPROM_BYTES; )
+  EEPROMReadCache cache;
+  cache.Length = 0;
+  
+  // Find the oldest block, that is the bottom, a read that fails ends the search 
+  // rather than stepping on a byte at a time (and retrying each)
+  for(x = 0; x < EEPROM_LOG_BYTES && !eepromFailed; )
   {
-    if(readEEPROMByte(x) == 0) { x++; continue; }
+    if(readEEPROMByte(x, cache) == 0) { x++; continue; }
         
     // readLogFrom will return the address of the next log entry if any
-    // or EEPROM_BYTES if not.
+    // or EEPROM_LOG_BYTES if not.
     
-    nxtPtr = readLogFrom(x, compareWith, 0, 0);    
+    nxtPtr = readLogFrom(x, compareWith, 0, 0, cache);    
     if(compareTimestamps(currentOldest,compareWith) > 0)
     {
       currentOldest        = compareWith;
@@ -195,62 +717,97 @@ uint16_t DS3231_Simple::findEEPROMReadAddress()
 
   return eepromReadAddress;
 }
+#endif
 
 // Clear some space int he EEPROM to record BytesRequired bytes, nulls
 //  any overlappig blocks.
-uint8_t DS3231_Simple::makeEEPROMSpace(uint16_t Address, int8_t BytesRequired)
+uint8_t DS3231_Simple::makeEEPROMSpace(EEPROMAddress Address, int16_t BytesRequired)
 {
-  if((Address+BytesRequired) >= EEPROM_BYTES) 
+  if((Address+BytesRequired) > EEPROM_LOG_BYTES) 
   {
     return 0;  // No can do.   
   }
-  uint8_t x;
-  while(BytesRequired > 0)
+  
+  uint8_t       x;
+  EEPROMAddress start = Address;
+  EEPROMAddress end   = Address + BytesRequired;
+  EEPROMAddress first = EEPROM_LOG_BYTES;
+  EEPROMReadCache cache;
+  cache.Length = 0;
+  
+  // Find the blocks overlapping the space, and where the last one ends
+  while(Address < end && !eepromFailed)
   {
-    x = readEEPROMByte(Address);
+    x = readEEPROMByte(Address, cache);
     if(x == 0) // Already blank
     {
-      BytesRequired--;
       Address++;
       continue;
     }
-    else
-    {  
-      uint16_t oldEepromWriteAddress = eepromWriteAddress;
-      eepromWriteAddress = Address;
-      
-      writeBytePagewizeStart();
-      for(x = ((x>>5) + 5); x > 0; x-- )
-      {
-        writeBytePagewize(0);
-      }
-      writeBytePagewizeEnd();
-      eepromWriteAddress = oldEepromWriteAddress;                
-    }
+    
+    if(first == EEPROM_LOG_BYTES) first = Address;
+    
+    // If that was the oldest block, the reader moves on to the next
+    if(eepromReadAddress == Address) eepromReadAddress = Address + (x>>5) + 5;
+    
+    Address = Address + (x>>5) + 5;
   }
   
+  // A block we couldn't read could be anything
+  if(eepromFailed) return 0;
+  
+  // And nuke them all in one go
+  if(first < Address)
+  {
+    clearEEPROM(first, Address);
+    if(eepromFailed) return 0;
+  }
+  
+  // If the reader was waiting in blank space that is about to be written over, the 
+  // oldest block is now after it (and if left there, it could end up in the middle of a block).
+  if(eepromReadAddress > start && eepromReadAddress < Address) eepromReadAddress = Address;
+  
   return 1;
 }
 
 uint8_t DS3231_Simple::writeBytePagewizeStart()
 {
-  Wire.beginTransmission(EEPROM_ADDRESS);
-  Wire.write((eepromWriteAddress >> 8) & 0xFF);
-  Wire.write(eepromWriteAddress & 0xFF);
+  eepromGeneration++;
+  
+#ifdef USE_ASYNC_LOG
+  if(eepromWriteDeferred)
+  {
+    openEEPROMWriteSlot();
+    return 1;
+  }
+#endif
+
+  EEPROM_WIRE.beginTransmission(EEPROM_DEVICE);
+  EEPROM_WIRE.write((uint8_t) ((eepromWriteAddress >> 8) & 0xFF));
+  EEPROM_WIRE.write((uint8_t) (eepromWriteAddress & 0xFF));
   return 1;
 }
 
 uint8_t DS3231_Simple::writeBytePagewize(const uint8_t data)
 {
-  Wire.write(data);
+#ifdef USE_ASYNC_LOG
+  if(eepromWriteDeferred)
+  {
+    EEPROMWriteSlot &slot = eepromWriteSlots[(eepromWriteSlotHead + eepromWriteSlotCount - 1) % LOG_WRITE_SLOTS];
+    slot.Data[eepromWriteAddress - slot.Address] = data;
+    if(eepromWriteAddress - slot.Address >= slot.Length) slot.Length = eepromWriteAddress - slot.Address + 1;
+  }
+  else
+#endif
+  EEPROM_WIRE.write(data);
     
-  // Because of the 32 byte buffer limitation in Wire, we are 
-  //  using 4 bits as the page size for a page of 16 bytes
-  //  even though the actual page size is probably higher
+  // Because of the buffer limitation in Wire (32 bytes on AVR), we are 
+  //  writing in chunks of EEPROM_WRITE_CHUNK bytes, which may be
+  //  less than the actual page size
   //  (it needs to be a binary multiple for this to work).  
   eepromWriteAddress++;
   
-  if(eepromWriteAddress < EEPROM_BYTES && ((eepromWriteAddress >>4) & 0xFF) != (((eepromWriteAddress-1)>>4) & 0xFF))
+  if(eepromWriteAddress < EEPROM_BYTES && !(eepromWriteAddress % EEPROM_WRITE_CHUNK))
   {
     // This is a new page, finish the previous write and start a new one
     writeBytePagewizeEnd();
@@ -262,74 +819,437 @@ uint8_t DS3231_Simple::writeBytePagewize(const uint8_t data)
 
 uint8_t DS3231_Simple::writeBytePagewizeEnd()
 {
-  if(Wire.endTransmission() > 0)
+#ifdef USE_ASYNC_LOG
+  // The slot is sent by serviceLog() later.
+  if(eepromWriteDeferred) return 1;
+#endif
+
+  // The data is gone from the Wire buffer now, so this can't be tried again, 
+  // the log must find its positions again from what did get written.
+  uint8_t error = EEPROM_WIRE.endTransmission();
+  if(error > 0)
   {
-    // Failure
+    lastError    = error;
+    eepromFailed = 1;
     return 0;
   }
   
-  // Poll for write to complete
-  while(!Wire.requestFrom(EEPROM_ADDRESS,(uint8_t) 1));
+  // Poll for write to complete, but not forever if the EEPROM has gone away
+  unsigned long started = millis();
+  while(!EEPROM_WIRE.requestFrom(EEPROM_DEVICE,(uint8_t) 1))
+  {
+    COUNT_POLL();
+    if(millis() - started > DS3231_EEPROM_WRITE_TIMEOUT)
+    {
+      lastError    = ERROR_EEPROM_TIMEOUT;
+      eepromFailed = 1;
+      return 0;
+    }
+  }
   return 1;
 }
 
-uint8_t  DS3231_Simple::writeLog( const DateTime &timestamp,   const uint8_t *data, uint8_t size )
+#ifdef USE_ASYNC_LOG
+void DS3231_Simple::openEEPROMWriteSlot()
 {
-  if(size > 7) return 0; // Limit is 7 data bytes.
-  
-  if(eepromWriteAddress >= EEPROM_BYTES) findEEPROMWriteAddress();            // Uninitialized stack top, find it.
-  if((eepromWriteAddress + 5 + size) >= EEPROM_BYTES) eepromWriteAddress = 0; // Would overflow so wrap to start
-  
-  if(!makeEEPROMSpace(eepromWriteAddress, 5+size))   
+  if(eepromWriteSlotCount)
   {
-    return 0;
+    // If we are carrying on from (or going back over) the last slot, and still in 
+    // its chunk, it can be the same page write.
+    EEPROMWriteSlot &last = eepromWriteSlots[(eepromWriteSlotHead + eepromWriteSlotCount - 1) % LOG_WRITE_SLOTS];
+    if(   eepromWriteAddress >= last.Address 
+       && eepromWriteAddress <= last.Address + last.Length
+       && (eepromWriteAddress / EEPROM_WRITE_CHUNK) == (last.Address / EEPROM_WRITE_CHUNK))
+    {
+      return;
+    }
   }
   
-  writeBytePagewizeStart();  
-  writeBytePagewize((size<<5) | (timestamp.Dow<<2) | (timestamp.Year >> 6));     
-  writeBytePagewize((timestamp.Year<<2)  | (timestamp.Month >> 2));
-  writeBytePagewize((timestamp.Month<<6) | (timestamp.Day << 1) | (timestamp.Hour >>4));
-  writeBytePagewize((timestamp.Hour<<4)  | (timestamp.Minute>>2));
-  writeBytePagewize(((timestamp.Minute<<6)| (timestamp.Second)) & 0xFF);  
+  if(eepromWriteSlotCount == LOG_WRITE_SLOTS)
+  {
+    // No room, have to write the oldest now (it must be finished before we can 
+    // read the EEPROM again).
+    if(!(waitEEPROMWrite() && sendEEPROMWriteSlot() && waitEEPROMWrite()))
+    {
+      eepromWriteError = 1;
+      if(eepromWriteSlotCount == LOG_WRITE_SLOTS) 
+      {
+        eepromWriteSlotHead = (eepromWriteSlotHead + 1) % LOG_WRITE_SLOTS;
+        eepromWriteSlotCount--;
+      }
+    }
+  }
+  
+  EEPROMWriteSlot &slot = eepromWriteSlots[(eepromWriteSlotHead + eepromWriteSlotCount) % LOG_WRITE_SLOTS];
+  slot.Address = eepromWriteAddress;
+  slot.Length  = 0;
+  eepromWriteSlotCount++;
+}
+
+uint8_t DS3231_Simple::sendEEPROMWriteSlot()
+{
+  EEPROMWriteSlot &slot = eepromWriteSlots[eepromWriteSlotHead];
+  
+  eepromWriteSlotHead = (eepromWriteSlotHead + 1) % LOG_WRITE_SLOTS;
+  eepromWriteSlotCount--;
+  
+  if(!slot.Length) return 1;
+  
+  uint8_t attempt = 0;
+  uint8_t error;
+  do
+  {
+    EEPROM_WIRE.beginTransmission(EEPROM_DEVICE);
+    EEPROM_WIRE.write((uint8_t) ((slot.Address >> 8) & 0xFF));
+    EEPROM_WIRE.write((uint8_t) (slot.Address & 0xFF));
+    EEPROM_WIRE.write(slot.Data, slot.Length);
+    error = EEPROM_WIRE.endTransmission();
+  } while(error && retryI2C(error, attempt));
+  
+  if(error) return 0;
+  
+  eepromWriteBusy    = 1;
+  eepromWriteStarted = millis();
+  return 1;
+}
+
+uint8_t DS3231_Simple::waitEEPROMWrite()
+{
+  while(eepromWriteBusy && !EEPROM_WIRE.requestFrom(EEPROM_DEVICE,(uint8_t) 1))
+  {
+    COUNT_POLL();
+    if(millis() - eepromWriteStarted > DS3231_EEPROM_WRITE_TIMEOUT) 
+    {
+      lastError       = ERROR_EEPROM_TIMEOUT;
+      eepromWriteBusy = 0;
+      return 0;
+    }
+  }
+  
+  eepromWriteBusy = 0;
+  return 1;
+}
+
+uint8_t DS3231_Simple::serviceLog()
+{
+  COUNT_CALL(STATS_WRITE_LOG);
+  // Has the EEPROM finished the last page write yet?
+  if(eepromWriteBusy)
+  {
+    if(!EEPROM_WIRE.requestFrom(EEPROM_DEVICE,(uint8_t) 1))
+    {
+      COUNT_POLL();
+      if(millis() - eepromWriteStarted <= DS3231_EEPROM_WRITE_TIMEOUT) return LOG_BUSY;
+      lastError        = ERROR_EEPROM_TIMEOUT;
+      eepromWriteError = 1;
+    }
+    eepromWriteBusy = 0;
+  }
+  
+  // Send the next page write
+  if(!eepromWriteError && eepromWriteSlotCount)
+  {
+    if(sendEEPROMWriteSlot()) return LOG_BUSY;
+    eepromWriteError = 1;
+  }
+  
+  if(!eepromWriteError)
+  {
+    if(!logQueueCount) return LOG_IDLE;
+    
+    // Work out the queued log entries now (the EEPROM is not busy, so reading it as
+    // we need to is quick), and leave the page writes that makes for following calls.
+    // Take as many entries as should fit in the write slots, allowing for wiping 
+    // before and after them, and a page header, or a checkpoint, so we don't have to
+    // wait for a slot, but always at least one.
+    uint8_t  n = 0;
+    int16_t  bytes = 0;
+    while(   n < logQueueCount 
+          && logQueueHead + n < DS3231_LOG_QUEUE_LENGTH 
+          && (!n || bytes + 5 + logQueue[logQueueHead + n].Size <= (int16_t)((LOG_WRITE_SLOTS - 3) * EEPROM_WRITE_CHUNK) - EEPROM_PAGE_SIZE))
+    {
+      bytes += 5 + logQueue[logQueueHead + n].Size;
+      n++;
+    }
+    
+    eepromWriteDeferred = 1;
+    if(!writeLogs(&logQueue[logQueueHead], n)) eepromWriteError = 1;
+    eepromWriteDeferred = 0;
+    
+    logQueueHead   = (logQueueHead + n) % DS3231_LOG_QUEUE_LENGTH;
+    logQueueCount -= n;
+    
+    if(!eepromWriteError) return LOG_BUSY;
+  }
+  
+  // Something didn't get written, so what we have in RAM is not what is in the EEPROM, 
+  // give up on it all and find the writer again next time.  The reader stays put, 
+  // finding it again would bring back blocks whose clearing we just dropped.
+  eepromWriteError     = 0;
+  eepromWriteSlotCount = 0;
+  logQueueCount        = 0;
+  forgetLogAddresses(eepromReadAddress);
+  
+  return LOG_ERROR;
+}
+
+uint8_t DS3231_Simple::flushLog()
+{
+  COUNT_CALL(STATS_WRITE_LOG);
+  uint8_t status;
+  while((status = serviceLog()) == LOG_BUSY);
+  return status == LOG_IDLE;
+}
+#endif
+
+uint8_t  DS3231_Simple::writeLog( const DateTime &timestamp,   const uint8_t *data, uint8_t size )
+{
+  COUNT_CALL(STATS_WRITE_LOG);
+  if(size > 7) return 0; // Limit is 7 data bytes.
+  
+  LogEntry entry;
+  entry.Timestamp = timestamp;
+  entry.Size      = size;
+  memcpy(entry.Data, data, size);
+  
+  return writeLogs(&entry, 1);
+}
+
+uint8_t  DS3231_Simple::writeLogs( const LogEntry *Entries, uint8_t Count )
+{
+  COUNT_CALL(STATS_WRITE_LOG);
+  uint8_t i;
+  for(i = 0; i < Count; i++)
+  {
+    if(Entries[i].Size > 7) return 0; // Limit is 7 data bytes.
+  }
+  
+  if(!Count) return 1;
+  
+#ifdef USE_ASYNC_LOG
+  if(!eepromWriteDeferred)
+  {
+    // Just queue them up for serviceLog()
+    if(Count > DS3231_LOG_QUEUE_LENGTH - logQueueCount) return 0;
     
-  for(; size > 0; size--)
+    for(i = 0; i < Count; i++)
+    {
+      logQueue[(logQueueHead + logQueueCount++) % DS3231_LOG_QUEUE_LENGTH] = Entries[i];
+    }
+    return 1;
+  }
+#endif
+  
+  eepromFailed = 0;
+  
+  // Unless we overrun it, a failure part way leaves the reader where it is
+  EEPROMAddress oldEepromReadAddress = eepromReadAddress;
+  
+#ifdef USE_SEQUENCED_LOG
+  if(eepromWriteAddress >= EEPROM_LOG_BYTES) findEEPROMWriteAddress();            // Uninitialized stack top, find it.
+  if(eepromFailed)
   {
-    writeBytePagewize(*data);
-    data++;
-  }    
+    forgetLogAddresses(oldEepromReadAddress);
+    return 0;
+  }
+  
+  uint8_t  writing = 0, newPage = 0;
+  EEPROMAddress oldEepromWriteAddress, pageAddress;
+  
+  for(i = 0; i < Count; i++)
+  {
+    if(!(eepromWriteAddress % EEPROM_PAGE_SIZE) || ((eepromWriteAddress % EEPROM_PAGE_SIZE) + 5 + Entries[i].Size) > EEPROM_PAGE_SIZE)
+    {
+      // Doesn't fit in this page, start the next one.
+      
+      oldEepromWriteAddress = eepromWriteAddress;
+      pageAddress           = ((eepromWriteAddress + EEPROM_PAGE_SIZE - 1) / EEPROM_PAGE_SIZE) * EEPROM_PAGE_SIZE;
+      if(pageAddress >= EEPROM_LOG_BYTES) pageAddress = 0;
+      
+      // If we started this page, wipe what's left of it before moving on.
+      while(newPage && (eepromWriteAddress % EEPROM_PAGE_SIZE))
+      {
+        writeBytePagewize(0);
+      }
+      
+      // The pagewize write can carry straight on into the next page, but if we 
+      // jump (over the end of a page we didn't start, or back to zero) it has to restart.
+      if(writing && eepromWriteAddress != pageAddress)
+      {
+        writeBytePagewizeEnd();
+        writing = 0;
+      }
+      eepromWriteAddress = pageAddress;
+      
+      // If the reader has not finished with that page, it's lost those blocks, 
+      // move it on to the next page, which is now the oldest.  (Past the page
+      // header, so that the reader is not mistaken for having caught up if the
+      // writer finishes this page and ends up at the start of that one.)
+      if(eepromReadAddress != oldEepromWriteAddress && (eepromReadAddress / EEPROM_PAGE_SIZE) == (eepromWriteAddress / EEPROM_PAGE_SIZE))
+      {
+        eepromReadAddress = ((eepromWriteAddress + EEPROM_PAGE_SIZE) % EEPROM_LOG_BYTES) + LOG_PAGE_HEADER;
+      }
+      
+      eepromWriteSequence = (eepromWriteSequence == 65535) ? 1 : eepromWriteSequence + 1;
+      
+      if(!writing) 
+      {
+        writeBytePagewizeStart();
+        writing = 1;
+      }
+      writeBytePagewize(eepromWriteSequence & 0xFF);
+      writeBytePagewize(eepromWriteSequence >> 8);
+      newPage = 1;
+    }
+    else if(!writing)
+    {
+      // The rest of the page was cleared when it was started, just append.
+      writeBytePagewizeStart();
+      writing = 1;
+    }
+    
+    writeLogBlockPagewize(Entries[i].Timestamp, Entries[i].Data, Entries[i].Size);
+  }
+  
+  // A page we started gets the remains of whatever was in it before wiped in the same write.
+  EEPROMAddress nextWriteAddress = eepromWriteAddress;
+  while(newPage && (eepromWriteAddress % EEPROM_PAGE_SIZE))
+  {
+    writeBytePagewize(0);
+  }
   writeBytePagewizeEnd();
   
+  eepromWriteAddress = nextWriteAddress >= EEPROM_LOG_BYTES ? 0 : nextWriteAddress;
+#else
+#ifdef USE_LOG_SUPERBLOCK
+  if(eepromWriteAddress >= EEPROM_LOG_BYTES) restoreLogCheckpoint();             // Uninitialized stack top, find it.
+  if(oldEepromReadAddress < EEPROM_LOG_BYTES) eepromReadAddress = oldEepromReadAddress;  // Newer than the checkpoint's
+#else
+  if(eepromWriteAddress >= EEPROM_LOG_BYTES) findEEPROMWriteAddress();            // Uninitialized stack top, find it.
+#endif
+  if(eepromFailed)
+  {
+    forgetLogAddresses(oldEepromReadAddress);
+    return 0;
+  }
+  
+  uint8_t  n;
+  uint16_t bytes;
+  EEPROMAddress oldEepromWriteAddress = eepromWriteAddress;
+  oldEepromReadAddress                = eepromReadAddress;
+  EEPROMAddress firstAddress          = EEPROM_LOG_BYTES;
+  
+  i = 0;
+  while(i < Count)
+  {
+    if((eepromWriteAddress + 5 + Entries[i].Size) >= EEPROM_LOG_BYTES) eepromWriteAddress = 0; // Would overflow so wrap to start
+    if(firstAddress == EEPROM_LOG_BYTES) firstAddress = eepromWriteAddress;
+    
+    // As many blocks as fit before the top of the EEPROM are cleared for, and 
+    // then written, in one go.
+    for(bytes = 0, n = i; n < Count && (eepromWriteAddress + bytes + 5 + Entries[n].Size) < EEPROM_LOG_BYTES; n++)
+    {
+      bytes += 5 + Entries[n].Size;
+    }
+    
+    if(!makeEEPROMSpace(eepromWriteAddress, bytes))   
+    {
+      if(eepromFailed) forgetLogAddresses(eepromReadAddress == oldEepromReadAddress ? oldEepromReadAddress : EEPROM_LOG_BYTES);
+      return 0;
+    }
+    
+    writeBytePagewizeStart();  
+    while(i < n)
+    {
+      writeLogBlockPagewize(Entries[i].Timestamp, Entries[i].Data, Entries[i].Size);
+      i++;
+    }
+    writeBytePagewizeEnd();
+  }
+  
+  // If not even an empty block would fit at the top, the next one goes to zero, 
+  // do that now so the reader can't be left waiting up there.
+  if((eepromWriteAddress + 5) >= EEPROM_LOG_BYTES) eepromWriteAddress = 0;
+  
   // We must also clear any existing block in the next write address
   //  this ensures that if the reader catches up to us that it will only
   //  read a blank block
   makeEEPROMSpace(eepromWriteAddress, 5);
   
+  if(oldEepromReadAddress == oldEepromWriteAddress)
+  {
+    // The reader had caught up with us, the next to read is the first we just wrote.
+    eepromReadAddress = firstAddress;
+  }
+  else if(eepromReadAddress != oldEepromReadAddress)
+  {
+    // We have overrun the reader, the oldest block is now the first one after us, 
+    // don't leave the reader sitting in empty space, if we came around to there 
+    // it would look like it had caught up.
+    EEPROMReadCache cache;
+    cache.Length = 0;
+    eepromReadAddress = skipEEPROMBlanks((eepromWriteAddress + 1) % EEPROM_LOG_BYTES, cache);
+  }
+#endif
+  
+  // Something went wrong part way, what we think is in the EEPROM may not be
+  if(eepromFailed)
+  {
+    forgetLogAddresses(eepromReadAddress == oldEepromReadAddress ? oldEepromReadAddress : EEPROM_LOG_BYTES);
+    return 0;
+  }
+  
+#ifdef USE_LOG_SUPERBLOCK
+  if(eepromCheckpointCountdown <= Count) 
+  {
+    checkpointLog();
+  }
+  else
+  {
+    eepromCheckpointCountdown -= Count;
+  }
+#endif
+  
   return 1;  
 }
 
-uint16_t DS3231_Simple::readLogFrom( uint16_t Address, DateTime &timestamp,   uint8_t *data, uint8_t size )
+void DS3231_Simple::writeLogBlockPagewize( const DateTime &timestamp, const uint8_t *data, uint8_t size )
+{
+  writeBytePagewize((size<<5) | (timestamp.Dow<<2) | (timestamp.Year >> 6));     
+  writeBytePagewize((timestamp.Year<<2)  | (timestamp.Month >> 2));
+  writeBytePagewize((timestamp.Month<<6) | (timestamp.Day << 1) | (timestamp.Hour >>4));
+  writeBytePagewize((timestamp.Hour<<4)  | (timestamp.Minute>>2));
+  writeBytePagewize(((timestamp.Minute<<6)| (timestamp.Second)) & 0xFF);  
+    
+  for(uint8_t x = 0; x < size; x++)
+  {
+    writeBytePagewize(data[x]);
+  }    
+}
+
+DS3231_Simple::EEPROMAddress DS3231_Simple::readLogFrom( EEPROMAddress Address, DateTime &timestamp,   uint8_t *data, uint8_t size, EEPROMReadCache &Cache )
 {
   uint8_t b1, b2, datalength;
      
-  b1 = readEEPROMByte(Address++);
-  b2 = readEEPROMByte(Address++);
+  b1 = readEEPROMByte(Address++, Cache);
+  b2 = readEEPROMByte(Address++, Cache);
 
-  if(!b1) return EEPROM_BYTES+1;
+  if(!b1) return EEPROM_LOG_BYTES+1;
 
   datalength = (b1 >> 5);
     
   // <Timestamp> ::= 0Bzzzwwwyy yyyyyymm mmdddddh hhhhiiii iissssss 
-  timestamp.Dow   =  (b1 >> 2) | 0x03;
+  timestamp.Dow   =  (b1 >> 2) & 0x07;
   timestamp.Year  =  (b1 << 6) | (b2>>2);// & 0b11111111
 
-  b1 = readEEPROMByte(Address++);
+  b1 = readEEPROMByte(Address++, Cache);
   timestamp.Month =  ((b2 << 2) | (b1 >> 6)) & 0b00001111; 
   timestamp.Day   =  (b1 >> 1) & 0b00011111;
   
-  b2 = readEEPROMByte(Address++);
+  b2 = readEEPROMByte(Address++, Cache);
   timestamp.Hour =  ((b1 << 4) | (b2 >> 4)) & 0b00011111;
 
-  b1 = readEEPROMByte(Address++);
+  b1 = readEEPROMByte(Address++, Cache);
   timestamp.Minute = ((b2 << 2) | (b1 >> 6)) & 0b00111111;
   timestamp.Second = b1 & 0b00111111;
 
@@ -339,288 +1259,1651 @@ uint16_t DS3231_Simple::readLogFrom( uint16_t Address, DateTime &timestamp,   ui
     if(size) 
     {
       size--;
-      *data = readEEPROMByte(Address);
+      *data = readEEPROMByte(Address, Cache);
       data++;
     }
            
     Address++;
   }
 
-  // If we have caught up with the writer, return that as the next read
-  if(Address == eepromWriteAddress) return Address;
+#ifdef USE_SEQUENCED_LOG
+  // readLog() will skip over any blank space and page headers to the next block
+  if(Address >= EEPROM_LOG_BYTES) Address = 0;
+  
+  // But step over the header of the next page now (unless the writer is waiting there), 
+  // otherwise when the writer gets to the start of that page, a whole lap later, it
+  // would look like the reader had caught up with it.
+  if(!(Address % EEPROM_PAGE_SIZE) && Address != eepromWriteAddress) Address += LOG_PAGE_HEADER;
+  
+  return Address;
+#else
+  // Skip any empty space to the next block, or the writer if we have caught up with it,
+  // (going around to zero if we get to the top).  The reader must not be left sitting 
+  // in empty space, if the writer came around to there it would look like we had caught up.
+  if(Address >= EEPROM_LOG_BYTES) Address = 0;
+  return skipEEPROMBlanks(Address, Cache);
+#endif
+}
+
+uint8_t DS3231_Simple::findLogAddresses()
+{
+  COUNT_CALL(STATS_OTHER);
+  const EEPROMAddress oldEepromReadAddress = eepromReadAddress;
+  
+  // Each log operation starts afresh, which is us when called from setup()
+  eepromFailed = 0;
+  
+#if defined(USE_LOG_SUPERBLOCK)
+  if(eepromReadAddress >= EEPROM_LOG_BYTES || eepromWriteAddress >= EEPROM_LOG_BYTES) restoreLogCheckpoint();
+  
+  // A reader we kept (see forgetLogAddresses()) is newer than the checkpoint's
+  if(oldEepromReadAddress < EEPROM_LOG_BYTES) eepromReadAddress = oldEepromReadAddress;
+#else
+  if(eepromWriteAddress >= EEPROM_LOG_BYTES) findEEPROMWriteAddress();
+  if(eepromReadAddress >= EEPROM_LOG_BYTES)  findEEPROMReadAddress();
+#endif
+
+  // Positions found from a bad read are no good
+  if(eepromFailed)
+  {
+    forgetLogAddresses(oldEepromReadAddress);
+    return 0;
+  }
+  return 1;
+}
+
+void DS3231_Simple::forgetLogAddresses(const EEPROMAddress ReadAddress)
+{
+  eepromWriteAddress   = EEPROM_LOG_BYTES;
+#ifdef USE_SEQUENCED_LOG
+  // The writer is found after the last unread block, which only agrees with a reader found the same way
+  eepromReadAddress    = EEPROM_LOG_BYTES;
+  (void) ReadAddress;
+#else
+  eepromReadAddress    = ReadAddress;
+#endif
+#ifdef USE_LOG_SUPERBLOCK
+  eepromCheckpointWriteAddress = EEPROM_LOG_BYTES;
+#endif
+}
+
+uint8_t DS3231_Simple::readLog( DateTime &timestamp,   uint8_t *data, uint8_t size )
+{
+  COUNT_CALL(STATS_READ_LOG);
+#ifdef USE_ASYNC_LOG
+  flushLog();
+#endif
+
+  eepromFailed = 0;
+  
+  // Initialize the read address
+  if(!findLogAddresses()) return 0;
+
+  // Is it still empty?
+  if(eepromReadAddress >= EEPROM_LOG_BYTES)
+  {
+    // No log block was found.    
+    return 0;
+  }
+  
+  EEPROMReadCache cache;
+  cache.Length = 0;
+  
+  // The reader may have been left sitting on blank space (the writer overwrote 
+  // the oldest blocks, or we restored from a checkpoint), move up to the next block.
+  EEPROMAddress readAddress = skipEEPROMBlanks(eepromReadAddress, cache);
+  if(eepromFailed) return 0;
+  
+  eepromReadAddress = readAddress;
+  if(eepromReadAddress >= EEPROM_LOG_BYTES || eepromReadAddress == eepromWriteAddress)
+  {
+    return 0;
+  }
+  
+  EEPROMAddress nextReadAddress = readLogFrom(eepromReadAddress, timestamp, data, size, cache);
+
+  if(nextReadAddress == EEPROM_LOG_BYTES+1 || eepromFailed) 
+  {    
+    // Indicates no log entry was read (0 start byte), or it couldn't be 
+    return 0;
+  }
+      
+#ifdef USE_LOG_SUPERBLOCK
+  // If that block was written since the last checkpoint, after a reset the writer could
+  // not be rolled forward past the hole we are about to make, so we will need to checkpoint.
+  uint8_t checkpoint = !--eepromCheckpointCountdown 
+    || eepromCheckpointWriteAddress >= EEPROM_LOG_BYTES
+    || ((eepromReadAddress + EEPROM_LOG_BYTES - eepromCheckpointWriteAddress) % EEPROM_LOG_BYTES) < ((eepromWriteAddress + EEPROM_LOG_BYTES - eepromCheckpointWriteAddress) % EEPROM_LOG_BYTES);
+#endif
+  
+  // Was read OK so we need to kill that byte, we won't trust the user to have
+  // given the correct size here, instead read the start byte
+  if(!makeEEPROMSpace(eepromReadAddress, (readEEPROMByte(eepromReadAddress, cache)>>5)+5))
+  {
+    // We don't know what got cleared, it will be read again if it wasn't
+    forgetLogAddresses(eepromReadAddress);
+    return 0;
+  }
+  
+  eepromReadAddress = nextReadAddress;
+  
+#ifdef USE_LOG_SUPERBLOCK
+  if(checkpoint) checkpointLog();
+#endif
+  
+  return 1;
+}
+
+uint8_t DS3231_Simple::beginLog( LogCursor &Cursor )
+{
+  COUNT_CALL(STATS_READ_LOG);
+#ifdef USE_ASYNC_LOG
+  flushLog();
+#endif
+
+  eepromFailed = 0;
+  findLogAddresses();
+  
+  Cursor.Address      = eepromReadAddress;
+  Cursor.Generation   = eepromGeneration;
+  Cursor.Cache.Length = 0;
+  
+  return eepromReadAddress < EEPROM_LOG_BYTES;
+}
+
+uint8_t DS3231_Simple::nextLog( LogCursor &Cursor, DateTime &timestamp, uint8_t *data, uint8_t size )
+{
+  COUNT_CALL(STATS_READ_LOG);
+#ifdef USE_ASYNC_LOG
+  flushLog();
+#endif
+
+  if(Cursor.Address >= EEPROM_LOG_BYTES) return 0;
+  
+  eepromFailed = 0;
+  
+  // If anything has been written since the cursor last read (logged, or read and 
+  // cleared by readLog() or acknowledgeLog()), what it has buffered may be out of date.
+  if(Cursor.Generation != eepromGeneration)
+  {
+    Cursor.Generation   = eepromGeneration;
+    Cursor.Cache.Length = 0;
+  }
+  
+  Cursor.Address = skipEEPROMBlanks(Cursor.Address, Cursor.Cache);
+  if(Cursor.Address >= EEPROM_LOG_BYTES || Cursor.Address == eepromWriteAddress)
+  {
+    return 0;
+  }
+  
+  EEPROMAddress nextAddress = readLogFrom(Cursor.Address, timestamp, data, size, Cursor.Cache);
+  if(nextAddress == EEPROM_LOG_BYTES+1 || eepromFailed)
+  {
+    return 0;
+  }
+  
+  Cursor.Address = nextAddress;
+  return 1;
+}
+
+uint8_t DS3231_Simple::seekLog( LogCursor &Cursor, const DateTime &From )
+{
+  COUNT_CALL(STATS_READ_LOG);
+  EEPROMAddress before;
+  DateTime      timestamp;
+  
+  while(1)
+  {
+    before = Cursor.Address;
+    if(!nextLog(Cursor, timestamp, 0, 0)) return 0;
+    
+    if(compareTimestamps(timestamp, From) >= 0)
+    {
+      // Back up so that this is the next entry returned.
+      Cursor.Address = before;
+      return 1;
+    }
+  }
+}
+
+uint8_t DS3231_Simple::acknowledgeLog( const LogCursor &Cursor )
+{
+  COUNT_CALL(STATS_READ_LOG);
+#ifdef USE_ASYNC_LOG
+  flushLog();
+#endif
+
+  if(Cursor.Address >= EEPROM_LOG_BYTES) return 0;
+  
+  eepromFailed = 0;
+  if(!findLogAddresses()) return 0;
+  if(eepromReadAddress >= EEPROM_LOG_BYTES || eepromWriteAddress >= EEPROM_LOG_BYTES) return 0;
+  
+  // The cursor must be between the reader and the writer (going around the ring), if 
+  // readLog() has already gone past it there is nothing before it left to clear, and
+  // going from the reader "around" to it would wipe the whole log.
+  if(((Cursor.Address + EEPROM_LOG_BYTES - eepromReadAddress) % EEPROM_LOG_BYTES) 
+      > ((eepromWriteAddress + EEPROM_LOG_BYTES - eepromReadAddress) % EEPROM_LOG_BYTES))
+  {
+    return 0;
+  }
+  
+  // Wipe everything from the reader up to the cursor, a page write at a time
+  // rather than a write per block.
+  if(Cursor.Address < eepromReadAddress)
+  {
+    clearEEPROM(eepromReadAddress, EEPROM_LOG_BYTES);
+    clearEEPROM(0, Cursor.Address);
+  }
+  else
+  {
+    clearEEPROM(eepromReadAddress, Cursor.Address);
+  }
+  
+  if(eepromFailed)
+  {
+    // What did get cleared is skipped over by the reader
+    forgetLogAddresses(eepromReadAddress);
+    return 0;
+  }
+  
+  eepromReadAddress = Cursor.Address;
+  
+#ifdef USE_LOG_SUPERBLOCK
+  checkpointLog();
+#endif
+  
+  return 1;
+}
+
+void DS3231_Simple::clearEEPROM(const EEPROMAddress From, const EEPROMAddress To)
+{
+  if(From >= To) return;
+  
+  EEPROMAddress oldEepromWriteAddress = eepromWriteAddress;
+  eepromWriteAddress = From;
+  
+#ifdef USE_SEQUENCED_LOG
+  // Page headers are left alone  
+  if(eepromWriteAddress % EEPROM_PAGE_SIZE < LOG_PAGE_HEADER)
+  {
+    eepromWriteAddress += LOG_PAGE_HEADER - (eepromWriteAddress % EEPROM_PAGE_SIZE);
+  }
+#endif
+  
+  writeBytePagewizeStart();
+  while(eepromWriteAddress < To && !eepromFailed)
+  {
+#ifdef USE_SEQUENCED_LOG
+    if(!(eepromWriteAddress % EEPROM_PAGE_SIZE))
+    {
+      writeBytePagewizeEnd();
+      eepromWriteAddress += LOG_PAGE_HEADER;
+      writeBytePagewizeStart();
+      continue;
+    }
+#endif
+    writeBytePagewize(0);
+  }
+  if(!eepromFailed) writeBytePagewizeEnd();
+  
+  eepromWriteAddress = oldEepromWriteAddress;
+}
+
+DS3231_Simple::EEPROMAddress DS3231_Simple::skipEEPROMBlanks(EEPROMAddress Address, EEPROMReadCache &Cache)
+{
+  uint8_t wrapped = 0;
+  
+  // A read that fails is not a blank, stop there (the caller sees eepromFailed)
+  while(Address != eepromWriteAddress && !eepromFailed)
+  {
+#ifdef USE_SEQUENCED_LOG
+    // Step over the page header
+    if(!(Address % EEPROM_PAGE_SIZE))
+    {
+      Address += LOG_PAGE_HEADER;
+      continue;
+    }
+#endif
+    
+    if(readEEPROMByte(Address, Cache)) break;
+    
+    if(++Address >= EEPROM_LOG_BYTES)
+    {
+      if(wrapped) break; // Been all the way around, nothing here.
+      wrapped = 1;
+      Address = 0;
+    }
+  }
+  
+  return Address;
+}
+
+#ifdef USE_LOG_SUPERBLOCK
+uint8_t DS3231_Simple::checkpointLog()
+{
+#ifdef USE_ASYNC_LOG
+  // Unless we are already writing out the queue
+  if(!eepromWriteDeferred) flushLog();
+#endif
+
+  if(eepromWriteAddress >= EEPROM_LOG_BYTES || eepromReadAddress >= EEPROM_LOG_BYTES) return 0;
+  
+  uint8_t  slot[LOG_SUPERBLOCK_SLOT_SIZE];
+  uint8_t  x;
+  
+  eepromCheckpointSequence++;
+  eepromCheckpointCountdown = LOG_SUPERBLOCK_INTERVAL;
+  
+  eepromCheckpointWriteAddress = eepromWriteAddress;
+  
+  slot[0] = eepromCheckpointSequence & 0xFF;
+  slot[1] = eepromCheckpointSequence >> 8;
+  slot[2] = eepromWriteAddress & 0xFF;
+  slot[3] = eepromWriteAddress >> 8;
+  slot[4] = eepromReadAddress & 0xFF;
+  slot[5] = eepromReadAddress >> 8;
+  slot[6] = LOG_SUPERBLOCK_MAGIC;
+  
+  // Checksum is seeded so that an all-zero (formatted) slot is not valid
+  slot[7] = 0xA5;
+  for(x = 0; x < LOG_SUPERBLOCK_SLOT_SIZE-1; x++) slot[7] += slot[x];
+  
+  EEPROMAddress oldEepromWriteAddress = eepromWriteAddress;
+  eepromWriteAddress = EEPROM_LOG_BYTES + (eepromCheckpointSequence % LOG_SUPERBLOCK_SLOTS) * EEPROM_PAGE_SIZE;
+  
+  writeBytePagewizeStart();
+  for(x = 0; x < LOG_SUPERBLOCK_SLOT_SIZE; x++)
+  {
+    writeBytePagewize(slot[x]);
+  }
+  x = writeBytePagewizeEnd();
+  
+  eepromWriteAddress = oldEepromWriteAddress;
+  return x;
+}
+
+void DS3231_Simple::restoreLogCheckpoint()
+{
+  uint8_t  slot[LOG_SUPERBLOCK_SLOT_SIZE];
+  uint8_t  x, sum, found = 0;
+  uint16_t      seq = 0;
+  EEPROMAddress wr = 0, rd = 0, Address;
+  
+  EEPROMReadCache cache;
+  cache.Length = 0;
+  
+  // Find the newest good slot, one at the start of each superblock page
+  for(Address = EEPROM_LOG_BYTES; Address < EEPROM_BYTES; Address += EEPROM_PAGE_SIZE)
+  {
+    if(!readEEPROMBytes(Address, slot, LOG_SUPERBLOCK_SLOT_SIZE)) break;
+    
+    sum = 0xA5;
+    for(x = 0; x < LOG_SUPERBLOCK_SLOT_SIZE-1; x++) sum += slot[x];
+    
+    if(slot[6] != LOG_SUPERBLOCK_MAGIC || slot[7] != sum) continue; // Blank or torn.
+    
+    if(!found || (int16_t)((slot[0] | (slot[1] << 8)) - seq) > 0)
+    {
+      found = 1;
+      seq   = slot[0] | (slot[1] << 8);
+      wr    = slot[2] | (slot[3] << 8);
+      rd    = slot[4] | (slot[5] << 8);
+    }
+  }
+  
+  // Nothing to go on, findLogAddresses() forgets what we have
+  if(eepromFailed) return;
+  
+  if(found && wr < EEPROM_LOG_BYTES && rd < EEPROM_LOG_BYTES)
+  {
+    eepromCheckpointSequence     = seq;
+    eepromCheckpointWriteAddress = wr;
+    
+    // Roll the writer forward over any blocks written since the checkpoint.
+    Address = wr;
+    while(Address < EEPROM_LOG_BYTES && (x = readEEPROMByte(Address, cache)) != 0)
+    {
+      Address = Address + (x >> 5) + 5;
+    }
+    
+    // If we ended up close enough to the top that the writer might have
+    // wrapped back to zero since the checkpoint, we can't tell from here.
+    if(Address + 5 + 7 < EEPROM_LOG_BYTES)
+    {
+      eepromWriteAddress = Address;
+      
+      // If the writer has overwritten where the reader was, then the oldest
+      // surviving block is whatever is after the writer now (not the writer 
+      // itself, that would look like the reader has caught up).
+      if(rd > wr && rd <= eepromWriteAddress)
+      {
+        rd = eepromWriteAddress + 1;
+      }
+      
+      // And the reader may have read on past the checkpoint, don't leave it sitting
+      // in the empty space it left behind (see readLogFrom()).
+      eepromReadAddress = skipEEPROMBlanks(rd, cache);
+      return;
+    }
+  }
+  
+  // No usable checkpoint, do it the long way.
+  eepromCheckpointWriteAddress = EEPROM_LOG_BYTES;
+  findEEPROMWriteAddress();
+  eepromReadAddress = EEPROM_LOG_BYTES;
+  findEEPROMReadAddress();
+  
+  // Nothing to read, so the reader is waiting at the writer
+  if(eepromReadAddress >= EEPROM_LOG_BYTES) eepromReadAddress = eepromWriteAddress;
+}
+#endif
+
+
+DS3231_Simple::DateTime DS3231_Simple::read()
+{
+  DateTime currentDate = { };
+  read(currentDate);
+  return currentDate;
+}
+
+uint8_t DS3231_Simple::read(DateTime &currentDate)
+{
+  COUNT_CALL(STATS_READ);
+#ifdef USE_CACHED_CLOCK
+  unsigned long edgeMillis;
+  uint8_t       edges;
+  
+  noInterrupts();
+  edges      = clockEdges;
+  edgeMillis = clockEdgeMillis;
+  interrupts();
+  
+  // Each tick() is the start of another second
+  if(clockCacheValid && edges != clockCacheEdges)
+  {
+    addSeconds(clockCache, (uint8_t)(edges - clockCacheEdges));
+    clockCacheMillis = edgeMillis;
+    clockCacheEdges  = edges;
+  }
+  
+  if(!clockCacheValid || (millis() - clockSyncMillis) >= DS3231_CLOCK_RESYNC_INTERVAL)
+  {
+    // If the clock can't be read we carry on from what we knew
+    if(!syncClock() && !clockCacheValid)
+    {
+      currentDate = DateTime();
+      return 0;
+    }
+  }
+  
+  currentDate = clockCache;
+  addSeconds(currentDate, (millis() - clockCacheMillis) / 1000);
+  return 1;
+#else
+  if(readClock(currentDate)) return 1;
+  
+  currentDate = DateTime();
+  return 0;
+#endif
+}
+
+#ifdef USE_CACHED_CLOCK
+uint8_t DS3231_Simple::syncClock()
+{
+  DateTime      currentDate, predicted;
+  unsigned long now, edgeMillis;
+  uint8_t       edges;
+  
+  // If a tick() comes while we are reading the clock, we can't tell if 
+  // what we read was before or after it, so read it again.
+  do
+  {
+    noInterrupts();
+    edges      = clockEdges;
+    edgeMillis = clockEdgeMillis;
+    interrupts();
+    
+    now = millis();
+    if(!readClock(currentDate)) return 0;
+  } while(edges != clockEdges);
+  
+  // Where we thought the clock had got to
+  predicted = clockCache;
+  addSeconds(predicted, (now - clockCacheMillis) / 1000);
+  
+  if(edges && (now - edgeMillis) < 1000)
+  {
+    // That second started at the tick
+    clockCacheMillis = edgeMillis;
+  }
+  else if(clockCacheValid && !compareTimestamps(predicted, currentDate))
+  {
+    // The clock agrees with where we had got to, so we still know when the 
+    // second started as well as we did before.
+    clockCacheMillis = now - ((now - clockCacheMillis) % 1000);
+  }
+  else
+  {
+    // We only know it started no later than now.
+    clockCacheMillis = now;
+  }
+  
+  clockCache      = currentDate;
+  clockCacheEdges = edges;
+  clockSyncMillis = now;
+  clockCacheValid = 1;
+  return 1;
+}
+#endif
+
+uint8_t DS3231_Simple::daysInMonth(const uint8_t Year, const uint8_t Month)
+{
+  if(Month == 2) return (Year % 4) ? 28 : 29; // Same as the clock, which has 2100 as a leap year
+  if(Month == 4 || Month == 6 || Month == 9 || Month == 11) return 30;
+  return 31;
+}
+
+void DS3231_Simple::addSeconds(DateTime &Timestamp, int32_t Seconds)
+{
+  // Anything more than a day (or backwards) goes the long way around
+  if(Seconds < 0 || Seconds >= 86400L)
+  {
+    Timestamp = fromEpoch(toEpoch(Timestamp) + Seconds);
+    return;
+  }
+  
+  // Otherwise just carry through the fields, which is much cheaper than
+  // dividing it all out again on an 8 bit micro.
+  Seconds         += Timestamp.Second;
+  Timestamp.Second = Seconds % 60;
+  Seconds          = Seconds / 60 + Timestamp.Minute;  // Now minutes
+  Timestamp.Minute = Seconds % 60;
+  Seconds          = Seconds / 60 + Timestamp.Hour;    // Now hours
+  Timestamp.Hour   = Seconds % 24;
+  
+  if(Seconds >= 24)
+  {
+    Timestamp.Dow = (Timestamp.Dow % 7) + 1;
+    if(++Timestamp.Day > daysInMonth(Timestamp.Year, Timestamp.Month))
+    {
+      Timestamp.Day = 1;
+      if(++Timestamp.Month > 12)
+      {
+        Timestamp.Month = 1;
+        Timestamp.Year++;
+      }
+    }
+  }
+}
+
+DS3231_Simple::DateTime DS3231_Simple::fromEpoch(Epoch Seconds)
+{
+  DateTime Timestamp;
+  
+  Timestamp.Second = Seconds % 60;
+  Seconds         /= 60;
+  Timestamp.Minute = Seconds % 60;
+  Seconds         /= 60;
+  Timestamp.Hour   = Seconds % 24;
+  Seconds         /= 24;                                   // Now days
+  
+  // 2000-01-01 was a Saturday
+  Timestamp.Dow    = (Seconds + 5) % 7 + 1;
+  
+  // Every 4 years is 1461 days, the first of them a leap year
+  Timestamp.Year   = (Seconds / 1461) * 4;
+  Seconds          = Seconds % 1461;
+  if(Seconds >= 366)
+  {
+    Seconds       -= 1;
+    Timestamp.Year+= Seconds / 365;
+    Seconds        = Seconds % 365;
+  }
+  
+  Timestamp.Month  = 1;
+  while(Seconds >= daysInMonth(Timestamp.Year, Timestamp.Month))
+  {
+    Seconds       -= daysInMonth(Timestamp.Year, Timestamp.Month++);
+  }
+  Timestamp.Day    = Seconds + 1;
+  
+  return Timestamp;
+}
+
+uint8_t DS3231_Simple::resyncRegisters()
+{
+  registerShadowValid = 0;
+  
+  if(!rtc_i2c_read(0x07, sizeof(registerShadow))) return 0;
+  
+  for(uint8_t x = 0; x < sizeof(registerShadow); x++) registerShadow[x] = RTC_WIRE.read();
+  registerShadow[0xE - 0x7] &= ~_BV(5); // CONV clears itself
+  
+  registerShadowValid = 1;
+  return 1;
+}
+
+uint8_t DS3231_Simple::readRegister(const uint8_t Address, uint8_t &Data)
+{
+  if(Address < 0x07 || Address > 0x0E) return rtc_i2c_read_byte(Address, Data);
+  
+  if(!registerShadowValid && !resyncRegisters()) return 0;
+  
+  Data = registerShadow[Address - 0x07];
+  return 1;
+}
+
+uint8_t DS3231_Simple::writeRegisters(const uint8_t Address, const uint8_t *Data, const uint8_t Length)
+{
+  uint8_t x;
+  
+  // Nothing to do if we know the clock already has exactly this (setting CONV always 
+  // needs writing, it starts a temperature conversion).
+  if(registerShadowValid && Address >= 0x07 && Address + Length <= 0x0F)
+  {
+    for(x = 0; x < Length; x++)
+    {
+      if(registerShadow[Address - 0x07 + x] != Data[x]) break;
+    }
+    
+    if(x == Length) return 1;
+  }
+  
+  if(!rtc_i2c_write(Address, Data, Length))
+  {
+    // We don't know what made it
+    registerShadowValid = 0;
+    return 0;
+  }
+  
+  for(x = 0; x < Length; x++)
+  {
+    if(Address + x >= 0x07 && Address + x <= 0x0E)
+    {
+      registerShadow[Address + x - 0x07] = Data[x];
+    }
+  }
+  registerShadow[0xE - 0x7] &= ~_BV(5);
+  
+  return 1;
+}
+
+uint8_t DS3231_Simple::writeRegister(const uint8_t Address, const uint8_t Data)
+{
+  return writeRegisters(Address, &Data, 1);
+}
+
+uint8_t DS3231_Simple::readClock(DateTime &currentDate)
+{
+  // Read in the 7 bytes which store the
+  //  Seconds, Minutes, Hours, Day-Of-Week, Day, Month, Year
+  if(rtc_i2c_read(0x00, 7))
+  {
+    readClockRegisters(currentDate);
+    return 1;
+  }  
+  return 0;
+}
+
+void DS3231_Simple::readClockRegisters(DateTime &currentDate)
+{
+  uint8_t  x; 
+  
+  currentDate.Second = bcd2bin(RTC_WIRE.read());
+  currentDate.Minute = bcd2bin(RTC_WIRE.read());
+  
+  // 6th Bit of hour indicates 12/24 Hour mode, we will always use 24 hour mode, because we is smart
+  x = RTC_WIRE.read();    
+  if(x & _BV(6))
+  {
+    currentDate.Hour = bcd2bin(x & 0B11111) + (x & _BV(5) ? 0 : 12);
+  }
+  else
+  {
+    currentDate.Hour = bcd2bin(x & 0B111111);
+  }
+  
+  currentDate.Dow = bcd2bin(RTC_WIRE.read());
+  currentDate.Day = bcd2bin(RTC_WIRE.read());
+  
+  x = RTC_WIRE.read();
+  // bit 7 of month indicates if the year is going to be 100+Year or just Year
+  if(x&_BV(7))
+  {
+    currentDate.Year = 100;
+  }
+  else
+  {
+    currentDate.Year = 0;
+  }
+  currentDate.Month = bcd2bin(x & 0B01111111);
+  currentDate.Year += bcd2bin(RTC_WIRE.read());
+}
+
+uint8_t DS3231_Simple::snapshot(Snapshot &Snap)
+{
+  COUNT_CALL(STATS_READ);
+  // The registers are contiguous, 0x00 to 0x12 is 19 bytes, which fits in 
+  // even the smallest Wire buffer.
+  if(!rtc_i2c_read(0x00, 0x13)) return 0;
+  
+  readClockRegisters(Snap.Time);
+  
+  // The alarm registers and control, 0x07 to 0x0E, refresh our copy
+  for(uint8_t x = 0; x < sizeof(registerShadow); x++) registerShadow[x] = RTC_WIRE.read();
+  Snap.Control        = registerShadow[0xE - 0x7];
+  registerShadow[0xE - 0x7] &= ~_BV(5); // CONV clears itself
+  registerShadowValid = 1;
+
+  Snap.Status         = RTC_WIRE.read();
+  Snap.Alarms         = Snap.Status & 0x3;
+  
+  RTC_WIRE.read(); // Aging offset, 0x10
+  
+  Snap.TemperatureMSB = RTC_WIRE.read();
+  Snap.TemperatureLSB = RTC_WIRE.read();
+  
+  return 1;
+}
+
+uint8_t DS3231_Simple::write(const DateTime &currentDate)
+{
+  COUNT_CALL(STATS_WRITE);
+  const uint8_t timeBytes[7] = {
+    bin2bcd(currentDate.Second),
+    bin2bcd(currentDate.Minute),
+    bin2bcd(currentDate.Hour),
+    bin2bcd(currentDate.Dow?currentDate.Dow:1), // People might not bother with Dow, make sure it's valid, in case.
+    bin2bcd(currentDate.Day),
+    bin2bcd(currentDate.Month),
+    bin2bcd(currentDate.Year)
+  };
+  
+  if(!rtc_i2c_write(0x00, timeBytes, sizeof(timeBytes))) return 0;
+  
+#ifdef USE_CACHED_CLOCK
+  // Writing the seconds restarts the clock's count of the second, so it starts now,
+  // not after the status is seen to below.
+  clockCache       = currentDate;
+  clockCache.Dow   = currentDate.Dow ? currentDate.Dow : 1;
+  clockCacheMillis = millis();
+  clockSyncMillis  = clockCacheMillis;
+  clockCacheEdges  = clockEdges;
+  clockCacheValid  = 1;
+#endif
+  
+  // The time is good now, clear the Oscillator Stop Flag (leaving the alarm flags alone)
+  // so that begin(BEGIN_WARM) can tell if it stops again.
+  uint8_t statusByte;
+  uint8_t Cleared = rtc_i2c_read_byte(0xF, statusByte);
+  if(Cleared && (statusByte & _BV(7)))
+  {
+    Cleared = rtc_i2c_write_byte(0xF, (statusByte | 0x3) & ~_BV(7));
+  }
+  
+  return Cleared;
+}
+
+uint8_t DS3231_Simple::enableSquareWave(const uint8_t Rate)
+{
+  uint8_t controlByte;
+  
+  if(!readRegister(0xE,controlByte)) return 0;
+  
+  // Clear CONV, RS2, RS1 and INTCN, keep the oscillator and alarm enables as they are
+  if(!writeRegister(0xE, (controlByte & 0B11000011) | (Rate & 0B00011000))) return 0;
+  
+  squareWaveRate = Rate & 0B00011000;
+  return 1;
+}
+
+uint8_t DS3231_Simple::disableSquareWave()
+{
+  uint8_t controlByte;
+  
+  if(!readRegister(0xE,controlByte)) return 0;
+  
+  // Set INTCN, the alarms then pull SQW low
+  if(!writeRegister(0xE, (controlByte & ~_BV(5)) | _BV(2))) return 0;
+  
+  squareWaveRate = SQW_OFF;
+  return 1;
+}
+
+uint8_t DS3231_Simple::enableTick(const uint8_t Pin, const uint8_t Rate, void (*Callback)())
+{
+  disableTick();
+  
+  if(!enableSquareWave(Rate)) return 0;
+  
+  noInterrupts();
+  tickCount     = 0;
+  tickCallback  = Callback;
+  interrupts();
+  tickCountSeen = 0;
+  tickPin       = Pin;
+  tickClock     = this;
+  
+  pinMode(Pin, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(Pin), tickInterrupt, FALLING);
+  return 1;
+}
+
+void DS3231_Simple::disableTick()
+{
+  if(tickClock != this) return;
+  
+  detachInterrupt(digitalPinToInterrupt(tickPin));
+  tickClock = NULL;
+}
+
+void IRAM_ATTR DS3231_Simple::tickInterrupt()
+{
+  if(tickClock) tickClock->tick();
+}
+
+void IRAM_ATTR DS3231_Simple::tick()
+{
+  tickCount++;
+  
+#ifdef USE_CACHED_CLOCK
+  // The 1Hz falling edge is when the seconds change, other rates don't line up
+  if(squareWaveRate == SQW_1HZ)
+  {
+    clockEdgeMillis = millis();
+    clockEdges++;
+  }
+#endif
+  
+  if(tickCallback) tickCallback();
+}
+
+uint32_t DS3231_Simple::getTicks()
+{
+  uint32_t Ticks;
+  
+  noInterrupts();
+  Ticks = tickCount;
+  interrupts();
+  
+  return Ticks;
+}
+
+uint32_t DS3231_Simple::ticked()
+{
+  uint32_t Ticks = getTicks();
+  uint32_t Count = Ticks - tickCountSeen;
+  
+  tickCountSeen = Ticks;
+  return Count;
+}
+
+uint8_t DS3231_Simple::setAlarm(const DateTime &AlarmDate, uint8_t AlarmMode)
+{
+  COUNT_CALL(STATS_ALARMS);
+  uint8_t controlByte;
+  
+  // Read the control byte, we will need to modify the alarm enable bits  
+  if(!readRegister(0xE,controlByte)) return 0;
+  
+  //if(AlarmMode >> 5 == 3) // Some custom modes we will rewrite the data and recurse with a standard mode
+  if((AlarmMode & 0B00000011) == 0B00000011) // Some custom modes we will rewrite the data and recurse with a standard mode
+  {
+    
+    // If AlarmDate was not declared as a constant reference
+    // we could force these, but it comes at a significant cost
+    // in flash consumption.
+    //
+    // AlarmDate.Hour    = 0;
+    // AlarmDate.Minute  = 0;
+    // AlarmDate.Day     = 1;
+    // AlarmDate.Dow     = 1;
+  
+    // Set to the equivalent Alarm Mode 2, 
+    //    for Hourly this will be Match Minute, 
+    //    for Daily it will be Match Minute and Match Hour,
+    //    for Weekly, Match Minute, Hour and Day-Of-Week (Dow)
+    //    for Montly, Match Minute, Hour, and Day-Of-Month (Date)
+    
+    AlarmMode         = AlarmMode & 0B11111110; 
+  }
+  
+  uint8_t alarmBytes[4];
+  uint8_t x = 0;
+  
+  //if(((AlarmMode >> 5) & 3) == 1) // Alarm 1 Modes
+  if(AlarmMode & 0B00000001)
+  {
+    // Alarm 1 data starts at 0x7
+    alarmBytes[x++] = bin2bcd(AlarmDate.Second) | (AlarmMode & 0B10000000);
+    controlByte = controlByte | _BV(0) | _BV(2); // Enable Alarm 1, set interrupt output on alarm.
+  }
+  else
+  {
+    // Alarm 2 data starts at 0xB
+    controlByte = controlByte | _BV(1) | _BV(2); // Enable Alarm 2, set interrupt output on alarm.
+  }    
+  AlarmMode = AlarmMode << 1;
+  
+  alarmBytes[x++] = bin2bcd(AlarmDate.Minute) | (AlarmMode & 0B10000000);  
+  AlarmMode = AlarmMode << 1;
+  
+  alarmBytes[x++] = bin2bcd(AlarmDate.Hour)   | (AlarmMode & 0B10000000);  
+  AlarmMode = AlarmMode << 1;
+  
+  if(AlarmMode & 0B01000000) // DOW indicator
+  {
+    alarmBytes[x++] = bin2bcd(AlarmDate.Dow)  | (AlarmMode & 0B10000000) | _BV(6);          
+  }
+  else
+  {
+    alarmBytes[x++] = bin2bcd(AlarmDate.Day)  | (AlarmMode & 0B10000000);
+  }    
+  AlarmMode = AlarmMode << 2;  // Value and Date/Day indicator
+  
+  if(!writeRegisters(x == 4 ? 0x7 : 0xB, alarmBytes, x)) return 0;
+  
+  // Write the control byte
+  if(!writeRegister(0xE, controlByte)) return 0;
+  squareWaveRate = SQW_OFF;
+  
+  return AlarmMode >> 5;
+}
+
+uint8_t DS3231_Simple::setAlarm(uint8_t AlarmMode)
+{
+  COUNT_CALL(STATS_ALARMS);
+  return setAlarm(read(), AlarmMode);
+}
+
+uint8_t DS3231_Simple::checkAlarms(uint8_t PauseClock, uint8_t ClearAlarms)
+{
+  COUNT_CALL(STATS_ALARMS);
+  uint8_t ControlByte = 0;
+  uint8_t StatusByte  = 0;
+  uint8_t StatusRead;
+  
+  // Left stopped last time, start it again before anything else
+  if(clockPaused) resumeClock();
+  
+  if(PauseClock && readRegister(0xE, ControlByte))
+  {
+    // Even if the write seems to fail it may have got there, so always resume after
+    clockPaused = 1;
+    writeRegister(0xE, ControlByte | _BV(7));
+  }
+  
+  StatusRead = rtc_i2c_read_byte(0xF, StatusByte);
+  if(StatusRead && ClearAlarms && (StatusByte & 0x3))
+  {
+    // Clear the alarm, if that fails it is still set and found next time
+    StatusRead = rtc_i2c_write_byte(0xF,StatusByte & ~0x3);
+  }
+  
+  if(clockPaused) resumeClock();
+  
+  return StatusRead ? (StatusByte & 0x3) : 0;
+}
+
+uint8_t DS3231_Simple::resumeClock()
+{
+  uint8_t ControlByte;
+  
+  if(!readRegister(0xE, ControlByte) || !writeRegister(0xE, ControlByte & ~_BV(7))) return 0;
+  
+  clockPaused = 0;
+  return 1;
+}
+
+uint8_t DS3231_Simple::checkAlarms(const Snapshot &Snap, uint8_t ClearAlarms)
+{
+  COUNT_CALL(STATS_ALARMS);
+  if(ClearAlarms && Snap.Alarms)
+  {
+    // Clear only the flags we saw (writing a 1 leaves a flag alone), in case 
+    // the other alarm has fired since
+    if(!rtc_i2c_write_byte(0xF, (Snap.Status | 0x3) & ~Snap.Alarms)) return 0;
+  }
+  
+  return Snap.Alarms;
+}
+
+uint8_t DS3231_Simple::disableAlarms()
+{
+  COUNT_CALL(STATS_ALARMS);
+  // There's no way to actually disable the alarms from triggering, so
+  // we have to set them to some unreachable date
+  // (NB: you can disable the alarms from putting the SQW pin low, but they still trigger
+  //   in the register itself, you can't stop that, hence this tom-foolery).
+  //
+  // (Using read() for this saves 4 bytes of flash, but the alarm registers would then 
+  //  be different every time, and so always rewritten, this way a second 
+  //  disableAlarms() finds nothing to change.)
+  DateTime invalid = { 0,0,0,0,31,2,0 }; 
+  if(!setAlarm(invalid, ALARM_MATCH_MINUTE_HOUR_DATE))        return 0;
+  if(!setAlarm(invalid, ALARM_MATCH_SECOND_MINUTE_HOUR_DATE)) return 0;
+  
+  // Kill the alarm flags, as checkAlarms() would, but checkAlarms() can't say
+  // whether there were none or they could not be cleared.
+  uint8_t statusByte;
+  if(!rtc_i2c_read_byte(0xF, statusByte)) return 0;
+  if((statusByte & 0x3) && !rtc_i2c_write_byte(0xF, statusByte & ~0x3)) return 0;
+  
+  return 1;  
+}
+
+#ifdef USE_SCHEDULER
+uint8_t DS3231_Simple::scheduleAt(const Epoch When, void (*Callback)(), const uint32_t Interval)
+{
+  uint8_t x;
+  
+  if(!Callback) return 0;
+  
+  for(x = 0; x < DS3231_SCHEDULER_JOBS; x++)
+  {
+    // A slot which is free, and not the job being called right now, which 
+    // might have cancelled itself and then scheduled another
+    if(!jobs[x].Callback && jobRunning != x + 1) break;
+  }
+  if(x == DS3231_SCHEDULER_JOBS) return 0;
+  
+  jobs[x].Due      = When;
+  jobs[x].Interval = Interval;
+  jobs[x].Callback = Callback;
+  pushJob(x);
+  
+  // Only if it's the new first, and not while runJobs() is going, it'll arm after
+  if(jobHeap[0] == x && !jobRunning) armJobAlarm();
+  
+  return x + 1;
+}
+
+uint8_t DS3231_Simple::scheduleEvery(const uint32_t Interval, void (*Callback)())
+{
+  return scheduleAt(toEpoch(read()) + Interval, Callback, Interval);
+}
+
+uint8_t DS3231_Simple::cancelJob(const uint8_t Job)
+{
+  if(!Job || Job > DS3231_SCHEDULER_JOBS || !jobs[Job-1].Callback) return 0;
+  
+  jobs[Job-1].Callback = NULL;
+  
+  // The job being called isn't in the heap right now, runJobs() won't put it back
+  if(jobRunning == Job) return 1;
+  
+  for(uint8_t x = 0; x < jobCount; x++)
+  {
+    if(jobHeap[x] == Job - 1)
+    {
+      removeJob(x);
+      
+      // We don't bother moving the alarm if it was the first, runJobs() will 
+      // find nothing to do then and set it for the next.
+      break;
+    }
+  }
+  
+  return 1;
+}
+
+uint8_t DS3231_Simple::runJobs()
+{
+  Epoch   Now;
+  uint8_t Count = 0;
+  uint8_t x;
+  uint8_t statusByte;
+  
+  // Clear the Alarm 1 flag so it lets go of SQW, but leave Alarm 2 alone
+  if(rtc_i2c_read_byte(0xF, statusByte) && (statusByte & _BV(0)))
+  {
+    rtc_i2c_write_byte(0xF, (statusByte | 0x3) & ~_BV(0));
+  }
+  
+  do
+  {
+    Now = toEpoch(read());
+    
+    while(jobCount && jobs[jobHeap[0]].Due <= Now)
+    {
+      x = jobHeap[0];
+      removeJob(0);
+      
+      jobRunning = x + 1;
+      jobs[x].Callback();
+      jobRunning = 0;
+      Count++;
+      
+      // Cancelled (by itself) or once only
+      if(!jobs[x].Callback) continue;
+      if(!jobs[x].Interval)
+      {
+        jobs[x].Callback = NULL;
+        continue;
+      }
+      
+      // Next time, skipping any we have missed entirely
+      jobs[x].Due += ((Now - jobs[x].Due) / jobs[x].Interval + 1) * jobs[x].Interval;
+      pushJob(x);
+    }
+    
+    armJobAlarm();
+    
+    // If the next is due so soon it may have passed while we were setting the alarm
+    // for it, the alarm won't go off for it, so look again.
+  } while(jobCount && jobs[jobHeap[0]].Due <= Now + 1 && jobs[jobHeap[0]].Due <= toEpoch(read()));
+  
+  return Count;
+}
+
+uint8_t DS3231_Simple::armJobAlarm()
+{
+  // Matching the date, hour, minute and second, if the job is a month or more away
+  // then this goes off early, runJobs() finds nothing due and just sets it again.
+  if(jobCount) return setAlarm(fromEpoch(jobs[jobHeap[0]].Due), ALARM_MATCH_SECOND_MINUTE_HOUR_DATE);
+  
+  // Nothing to do, never
+  DateTime invalid = { 0,0,0,0,31,2,0 }; 
+  return setAlarm(invalid, ALARM_MATCH_SECOND_MINUTE_HOUR_DATE);
+}
+
+void DS3231_Simple::pushJob(const uint8_t Index)
+{
+  jobHeap[jobCount] = Index;
+  siftJobUp(jobCount++);
+}
+
+void DS3231_Simple::removeJob(const uint8_t HeapPosition)
+{
+  jobHeap[HeapPosition] = jobHeap[--jobCount];
+  if(HeapPosition < jobCount)
+  {
+    siftJobDown(HeapPosition);
+    siftJobUp(HeapPosition);
+  }
+}
+
+void DS3231_Simple::siftJobUp(uint8_t HeapPosition)
+{
+  uint8_t Index = jobHeap[HeapPosition];
+  
+  while(HeapPosition)
+  {
+    uint8_t Parent = (HeapPosition - 1) / 2;
+    if(jobs[jobHeap[Parent]].Due <= jobs[Index].Due) break;
+    
+    jobHeap[HeapPosition] = jobHeap[Parent];
+    HeapPosition = Parent;
+  }
+  
+  jobHeap[HeapPosition] = Index;
+}
+
+void DS3231_Simple::siftJobDown(uint8_t HeapPosition)
+{
+  uint8_t Index = jobHeap[HeapPosition];
+  
+  while(true)
+  {
+    uint8_t Child = HeapPosition * 2 + 1;
+    if(Child >= jobCount) break;
+    
+    // The earlier of the two children
+    if(Child + 1 < jobCount && jobs[jobHeap[Child + 1]].Due < jobs[jobHeap[Child]].Due) Child++;
+    if(jobs[Index].Due <= jobs[jobHeap[Child]].Due) break;
+    
+    jobHeap[HeapPosition] = jobHeap[Child];
+    HeapPosition = Child;
+  }
+  
+  jobHeap[HeapPosition] = Index;
+}
+#endif
+
+int16_t DS3231_Simple::getTemperatureQuarters()
+{
+  COUNT_CALL(STATS_TEMPERATURE);
+  uint8_t t = 0;
+  if(rtc_i2c_read(0x11, 2))
+  {
+    t = RTC_WIRE.read();
+    return decodeTemperature(t, RTC_WIRE.read());
+  }
+  return 0;
+}
+
+int16_t DS3231_Simple::getTemperatureQuarters(const Snapshot &Snap)
+{
+  return decodeTemperature(Snap.TemperatureMSB, Snap.TemperatureLSB);
+}
+
+int16_t DS3231_Simple::decodeTemperature(const uint8_t MSB, const uint8_t LSB)
+{
+  // MSB is whole degrees, two's complement, and the top 2 bits of LSB the 
+  // number of 0.25 degree units above that, so together a signed 10 bit 
+  // number of quarter degrees.
+  return (int16_t) ((int8_t) MSB) * 4 + (LSB >> 6);
+}
+
+int8_t DS3231_Simple::roundTemperature(const int16_t Quarters)
+{
+  // Whole degrees below (>> rounds down, even when negative), and the number of 
+  // 0.25 degree units above that.  We will implement "Bankers Rounding"
+  // such that 0.5 (.25 * 2) is rounded to the nearest even number
+  int8_t  t = Quarters >> 2;
+  uint8_t x = Quarters & 0x03;
+  
+  if( ((x > 2) || (( x == 2 ) && (t & 0x01))) && t < 127) // (127.5 and up can't go up, but are well beyond what the clock will see)
+  {      
+    t++;    
+  }
+  
+  return t;
+}
+
+int8_t DS3231_Simple::getTemperature()
+{
+  return roundTemperature(getTemperatureQuarters());
+}
+
+int8_t DS3231_Simple::getTemperature(const Snapshot &Snap)
+{
+  return roundTemperature(getTemperatureQuarters(Snap));
+}
+
+int16_t DS3231_Simple::getTemperatureCentidegrees()
+{
+  return getTemperatureQuarters() * 25;
+}
+
+int16_t DS3231_Simple::getTemperatureCentidegrees(const Snapshot &Snap)
+{
+  return getTemperatureQuarters(Snap) * 25;
+}
+
+uint8_t DS3231_Simple::startTemperatureConversion()
+{
+  COUNT_CALL(STATS_TEMPERATURE);
+  uint8_t statusByte;
+  uint8_t controlByte;
   
-  while(Address < EEPROM_BYTES && (readEEPROMByte(Address) == 0))
-  {
-    Address++;
-  }
-
-  if(Address == EEPROM_BYTES && eepromWriteAddress < Address)
+  if(!rtc_i2c_read_byte(0xF, statusByte)) return 0;
+  
+  // BSY, it's measuring by itself already, and we mustn't start another on top
+  if(!(statusByte & _BV(2)))
   {
-    // There was nothing ahead of us, and the writer is behind us
-    //  which means this is all empty unusable space we just walked
-    //  so go to zero position
-    Address = 0;
+    // Set CONV, the clock clears it again when the measurement is done
+    if(!readRegister(0xE, controlByte)) return 0;
+    if(!writeRegister(0xE, controlByte | _BV(5))) return 0;
   }
   
-  return Address;
+  temperatureConverting = 1;
+  return 1;
 }
 
-uint8_t DS3231_Simple::readLog( DateTime &timestamp,   uint8_t *data, uint8_t size )
+uint8_t DS3231_Simple::temperatureReady()
 {
-  // Initialize the read address
-  if(eepromReadAddress >= EEPROM_BYTES) findEEPROMReadAddress();
-
-  // Is it still empty?
-  if(eepromReadAddress >= EEPROM_BYTES)
-  {
-    // No log block was found.    
-    return 0;
-  }
+  COUNT_CALL(STATS_TEMPERATURE);
+  if(!temperatureConverting) return 1;
   
-  uint16_t nextReadAddress = readLogFrom(eepromReadAddress, timestamp, data, size);
-
-  if(nextReadAddress == EEPROM_BYTES+1) 
-  {    
-    // Indicates no log entry was read (0 start byte) 
+  // Control and Status in one go, done when neither CONV or BSY is set
+  if(!rtc_i2c_read(0xE, 2)) return 0;
+  
+  if(RTC_WIRE.read() & _BV(5)) 
+  {
+    RTC_WIRE.read();
     return 0;
   }
-      
-  // Was read OK so we need to kill that byte, we won't trust the user to have
-  // given the correct size here, instead read the start byte
-  makeEEPROMSpace(eepromReadAddress, (readEEPROMByte(eepromReadAddress)>>5)+5);
+  if(RTC_WIRE.read() & _BV(2)) return 0;
   
-  eepromReadAddress = nextReadAddress;
+  temperatureConverting = 0;
   return 1;
 }
 
-
-DS3231_Simple::DateTime DS3231_Simple::read()
+#ifdef USE_ASYNC_REQUESTS
+uint8_t DS3231_Simple::queueRequest(const uint8_t Operation, const DateTime &Time, const uint8_t Mode, RequestCallback Callback, const uint8_t *Data)
 {
-  DateTime currentDate;
-  uint8_t  x; 
-
-  // Set the register address by doing a write of just the address
-  rtc_i2c_seek(0x00);
-
-  // Read in the 7 bytes which store the
-  //  Seconds, Minutes, Hours, Day-Of-Week, Day, Month, Year
-  if(Wire.requestFrom(RTC_ADDRESS,(uint8_t) 7) == 7)
+#ifdef USE_THREAD_SAFE_REQUESTS
+  uint32_t Position = __atomic_load_n(&requestQueued, __ATOMIC_RELAXED);
+  uint8_t  Slot;
+  
+  // Claim the next position, unless another task beats us to it
+  while(1)
   {
-    currentDate.Second = bcd2bin(Wire.read());
-    currentDate.Minute = bcd2bin(Wire.read());
+    Slot = Position % DS3231_REQUEST_QUEUE_LENGTH;
+    int32_t Turn = (int32_t)(__atomic_load_n(&requestTurn[Slot], __ATOMIC_ACQUIRE) + Slot - Position);
     
-    // 6th Bit of hour indicates 12/24 Hour mode, we will always use 24 hour mode, because we is smart
-    x = Wire.read();    
-    if(x & _BV(6))
-    {
-      currentDate.Hour = bcd2bin(x & 0B11111) + (x & _BV(5) ? 0 : 12);
-    }
-    else
+    if(Turn == 0)
     {
-      currentDate.Hour = bcd2bin(x & 0B111111);
+      if(__atomic_compare_exchange_n(&requestQueued, &Position, Position + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) break;
     }
-    
-    currentDate.Dow = bcd2bin(Wire.read());
-    currentDate.Day = bcd2bin(Wire.read());
-    
-    x = Wire.read();
-    // bit 7 of month indicates if the year is going to be 100+Year or just Year
-    if(x&_BV(7))
+    else if(Turn < 0)
     {
-      currentDate.Year = 100;
+      // Still queued from the last time round, full
+      return 0;
     }
     else
     {
-      currentDate.Year = 0;
+      Position = __atomic_load_n(&requestQueued, __ATOMIC_RELAXED);
     }
-    currentDate.Month = bcd2bin(x & 0B01111111);
-    currentDate.Year += bcd2bin(Wire.read());
-  }  
-  return currentDate;
+  }
+  
+  Request &Queued  = requests[Slot];
+#else
+  if(requestCount >= DS3231_REQUEST_QUEUE_LENGTH) return 0;
+  
+  Request &Queued  = requests[(requestHead + requestCount) % DS3231_REQUEST_QUEUE_LENGTH];
+#endif
+  Queued.Operation = Operation;
+  Queued.Mode      = Mode;
+  Queued.Time      = Time;
+  Queued.Result    = 0;
+  Queued.Success   = 0;
+  Queued.Callback  = Callback;
+  
+#ifdef USE_THREAD_SAFE_REQUESTS
+  if(Data) memcpy(Queued.Data, Data, Mode);
+  
+  // Now the owner can have it
+  __atomic_store_n(&requestTurn[Slot], Position + 1 - Slot, __ATOMIC_RELEASE);
+#else
+  (void) Data;
+  requestCount++;
+#endif
+  return 1;
 }
 
-uint8_t DS3231_Simple::write(const DateTime &currentDate)
+DS3231_Simple::Request *DS3231_Simple::oldestRequest()
 {
-  Wire.beginTransmission(RTC_ADDRESS);
-  Wire.write(0x00); // Start address of data
-  Wire.write(bin2bcd(currentDate.Second));
-  Wire.write(bin2bcd(currentDate.Minute));
-  Wire.write(bin2bcd(currentDate.Hour));
-  Wire.write(bin2bcd(currentDate.Dow?currentDate.Dow:1)); // People might not bother with Dow, make sure it's valid, in case.
-  Wire.write(bin2bcd(currentDate.Day));
-  Wire.write(bin2bcd(currentDate.Month));
-  Wire.write(bin2bcd(currentDate.Year));
-  return Wire.endTransmission() ? 0 : 1; // endTransmission returns a code in the response, to make it "Simple" we will return 0 for any fail, and 1 for OK
+#ifdef USE_THREAD_SAFE_REQUESTS
+  uint8_t Slot = requestDone % DS3231_REQUEST_QUEUE_LENGTH;
+  if(__atomic_load_n(&requestTurn[Slot], __ATOMIC_ACQUIRE) + Slot != requestDone + 1) return NULL;
+  return &requests[Slot];
+#else
+  return requestCount ? &requests[requestHead] : NULL;
+#endif
 }
 
-uint8_t DS3231_Simple::setAlarm(const DateTime &AlarmDate, uint8_t AlarmMode)
+void DS3231_Simple::removeOldestRequest()
 {
-  uint8_t controlByte;
-  
-  // Read the control byte, we will need to modify the alarm enable bits  
-  if(!rtc_i2c_read_byte(0xE,controlByte)) return 0;
+#ifdef USE_THREAD_SAFE_REQUESTS
+  uint8_t Slot = requestDone % DS3231_REQUEST_QUEUE_LENGTH;
+  __atomic_store_n(&requestTurn[Slot], requestDone + DS3231_REQUEST_QUEUE_LENGTH - Slot, __ATOMIC_RELEASE);
+  requestDone++;
+#else
+  requestHead  = (requestHead + 1) % DS3231_REQUEST_QUEUE_LENGTH;
+  requestCount--;
+#endif
+}
+
+uint8_t DS3231_Simple::requestRead(RequestCallback Callback)
+{
+  DateTime Unused = { };
+  return queueRequest(REQUEST_READ, Unused, 0, Callback);
+}
+
+uint8_t DS3231_Simple::requestWrite(const DateTime &Time, RequestCallback Callback)
+{
+  return queueRequest(REQUEST_WRITE, Time, 0, Callback);
+}
+
+uint8_t DS3231_Simple::requestAlarm(const DateTime &AlarmTime, uint8_t AlarmMode, RequestCallback Callback)
+{
+  return queueRequest(REQUEST_SET_ALARM, AlarmTime, AlarmMode, Callback);
+}
+
+uint8_t DS3231_Simple::requestCheckAlarms(RequestCallback Callback)
+{
+  DateTime Unused = { };
+  return queueRequest(REQUEST_CHECK_ALARMS, Unused, 0, Callback);
+}
+
+uint8_t DS3231_Simple::requestTemperature(RequestCallback Callback)
+{
+  DateTime Unused = { };
+  return queueRequest(REQUEST_TEMPERATURE, Unused, 0, Callback);
+}
+
+uint8_t DS3231_Simple::serviceRequests()
+{
+  Request *Oldest = oldestRequest();
   
-  //if(AlarmMode >> 5 == 3) // Some custom modes we will rewrite the data and recurse with a standard mode
-  if((AlarmMode & 0B00000011) == 0B00000011) // Some custom modes we will rewrite the data and recurse with a standard mode
+  if(!Oldest)
   {
-    
-    // If AlarmDate was not declared as a constant reference
-    // we could force these, but it comes at a significant cost
-    // in flash consumption.
-    //
-    // AlarmDate.Hour    = 0;
-    // AlarmDate.Minute  = 0;
-    // AlarmDate.Day     = 1;
-    // AlarmDate.Dow     = 1;
-  
-    // Set to the equivalent Alarm Mode 2, 
-    //    for Hourly this will be Match Minute, 
-    //    for Daily it will be Match Minute and Match Hour,
-    //    for Weekly, Match Minute, Hour and Day-Of-Week (Dow)
-    //    for Montly, Match Minute, Hour, and Day-Of-Month (Date)
-    
-    AlarmMode         = AlarmMode & 0B11111110; 
+    #ifdef USE_THREAD_SAFE_REQUESTS
+      // Nothing to do, keep the time for readShared() fresh
+      if(!sharedClockSequence || (millis() - sharedClockMillis[sharedClockSequence & 1]) >= DS3231_CLOCK_RESYNC_INTERVAL)
+      {
+        DateTime Now;
+        if(readClock(Now)) shareClock(Now, millis());
+      }
+    #endif
+    return REQUESTS_IDLE;
   }
   
-  Wire.beginTransmission(RTC_ADDRESS);
-  //if(((AlarmMode >> 5) & 3) == 1) // Alarm 1 Modes
-  if(AlarmMode & 0B00000001)
+  switch(Oldest->Operation)
   {
-    Wire.write(0x7); // Start address of data for Alarm1
-    Wire.write(bin2bcd(AlarmDate.Second) | (AlarmMode & 0B10000000));        
-    controlByte = controlByte | _BV(0) | _BV(2); // Enable Alarm 1, set interrupt output on alarm.
+    case REQUEST_READ:
+    {
+      // Counted as a read(), which it stands in for
+      COUNT_CALL(STATS_READ);
+      #ifdef USE_CACHED_CLOCK
+        // Someone asking for the time from the clock, may as well bring the cache up to date
+        Oldest->Success = readClock(Oldest->Time);
+        if(Oldest->Success) syncClock();
+      #else
+        Oldest->Success = readClock(Oldest->Time);
+      #endif
+      #ifdef USE_THREAD_SAFE_REQUESTS
+        if(Oldest->Success) shareClock(Oldest->Time, millis());
+      #endif
+      break;
+    }
+      
+    case REQUEST_WRITE:
+      Oldest->Success = write(Oldest->Time);
+      #ifdef USE_THREAD_SAFE_REQUESTS
+        if(Oldest->Success) shareClock(Oldest->Time, millis());
+      #endif
+      break;
+      
+    case REQUEST_SET_ALARM:
+      Oldest->Success = setAlarm(Oldest->Time, Oldest->Mode);
+      break;
+      
+    case REQUEST_CHECK_ALARMS:
+      Oldest->Result  = checkAlarms();
+      Oldest->Success = 1;
+      break;
+      
+    case REQUEST_TEMPERATURE:
+      if(!requestStarted)
+      {
+        if(startTemperatureConversion())
+        {
+          requestStarted = 1;
+          requestMillis  = millis();
+          return REQUESTS_BUSY;
+        }
+      }
+      else if(temperatureReady())
+      {
+        Oldest->Result  = getTemperatureQuarters();
+        Oldest->Success = 1;
+      }
+      else if((millis() - requestMillis) < REQUEST_TEMPERATURE_TIMEOUT)
+      {
+        return REQUESTS_BUSY;
+      }
+      else
+      {
+        // Stop waiting on it, a later measurement must start afresh
+        temperatureConverting = 0;
+      }
+      requestStarted = 0;
+      break;
+      
+    #ifdef USE_THREAD_SAFE_REQUESTS
+    case REQUEST_WRITE_LOG:
+      Oldest->Success = writeLog(Oldest->Time, Oldest->Data, Oldest->Mode);
+      break;
+    #endif
   }
-  else
-  {
-    Wire.write(0xB); // Start address of data for Alarm2
-    controlByte = controlByte | _BV(1) | _BV(2); // Enable Alarm 2, set interrupt output on alarm.
-  }    
-  AlarmMode = AlarmMode << 1;
-  
-  Wire.write(bin2bcd(AlarmDate.Minute) | (AlarmMode & 0B10000000));  
-  AlarmMode = AlarmMode << 1;
-  
-  Wire.write(bin2bcd(AlarmDate.Hour)   | (AlarmMode & 0B10000000));  
-  AlarmMode = AlarmMode << 1;
   
-  if(AlarmMode & 0B01000000) // DOW indicator
-  {
-    Wire.write(bin2bcd(AlarmDate.Dow)   | (AlarmMode & 0B10000000) | _BV(6));          
-  }
-  else
-  {
-    Wire.write(bin2bcd(AlarmDate.Day)   | (AlarmMode & 0B10000000));
-  }    
-  AlarmMode = AlarmMode << 2;  // Value and Date/Day indicator
-      
-  if(Wire.endTransmission()) return 0;
+  // Take it off the queue before the callback, which may queue another
+  Request Done = *Oldest;
+  removeOldestRequest();
   
-  // Write the control byte
-  if(rtc_i2c_write_byte(0xE, controlByte)) return 0;
+  if(Done.Callback) Done.Callback(Done);
   
-  return AlarmMode >> 5;
+  return oldestRequest() ? REQUESTS_BUSY : REQUESTS_IDLE;
 }
 
-uint8_t DS3231_Simple::setAlarm(uint8_t AlarmMode)
+#ifdef USE_THREAD_SAFE_REQUESTS
+uint8_t DS3231_Simple::requestLog(const DateTime &timestamp, const uint8_t *data, uint8_t size, RequestCallback Callback)
 {
-  return setAlarm(read(), AlarmMode);
+  if(size > sizeof(((Request *)0)->Data)) return 0;
+  return queueRequest(REQUEST_WRITE_LOG, timestamp, size, Callback, data);
 }
 
-uint8_t DS3231_Simple::checkAlarms(uint8_t PauseClock, uint8_t ClearAlarms)
+void DS3231_Simple::shareClock(const DateTime &Time, const unsigned long Millis)
 {
-  uint8_t StatusByte = 0;
+  uint32_t Sequence = sharedClockSequence + 1;
   
-  if(PauseClock)
-  {
-    if(rtc_i2c_read_byte(0xE,StatusByte))
-    {
-      rtc_i2c_write_byte(0xE, StatusByte | _BV(7));
-    }
-  }
+  // Readers are using the other copy
+  sharedClock[Sequence & 1]       = Time;
+  sharedClockMillis[Sequence & 1] = Millis;
   
-  rtc_i2c_read_byte(0xF,StatusByte);
-
-  if(ClearAlarms)
-  {
-  if(StatusByte & 0x3)
-  {
-    // Clear the alarm
-    rtc_i2c_write_byte(0xF,StatusByte & ~0x3);    
-  }
-  }
+  __atomic_store_n(&sharedClockSequence, Sequence, __ATOMIC_RELEASE);
+}
 
-  if(PauseClock)
+uint8_t DS3231_Simple::readShared(DateTime &Time)
+{
+  uint32_t      Sequence;
+  unsigned long Millis;
+  
+  while(1)
   {
-    if(rtc_i2c_read_byte(0xE, PauseClock))
-    {
-      rtc_i2c_write_byte(0xE, PauseClock & ~(_BV(7)));
-    }    
+    Sequence = __atomic_load_n(&sharedClockSequence, __ATOMIC_ACQUIRE);
+    if(!Sequence) return 0;
+    
+    Time   = sharedClock[Sequence & 1];
+    Millis = sharedClockMillis[Sequence & 1];
+    
+    // If the owner has moved on since, it may have been writing this copy while we read it
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if(__atomic_load_n(&sharedClockSequence, __ATOMIC_RELAXED) == Sequence) break;
   }
   
-  return StatusByte & 0x3;
+  addSeconds(Time, (millis() - Millis) / 1000);
+  return 1;
 }
+#endif
+#endif
 
-uint8_t DS3231_Simple::disableAlarms()
+float DS3231_Simple::getTemperatureFloat()
 {
-  // There's no way to actually disable the alarms from triggering, so
-  // we have to set them to some unreachable date
-  // (NB: you can disable the alarms from putting the SQW pin low, but they still trigger
-  //   in the register itself, you can't stop that, hence this tom-foolery).
-  #if 0
-  DateTime invalid = { 0,0,0,0,31,2,0 }; 
-  #else
-  // This saves 4 bytes interestingly (assuming you are already going to be using read() somewhere)
-  DateTime invalid = read();
-  invalid.Day = 31;
-  invalid.Month = 2;
-  #endif
-  setAlarm(invalid, ALARM_MATCH_MINUTE_HOUR_DATE);
-  setAlarm(invalid, ALARM_MATCH_SECOND_MINUTE_HOUR_DATE);
-  checkAlarms(); // A dummy check alarm to kill the alarm flags.
-  
-  return 1;  
+  return getTemperatureQuarters() * 0.25;
 }
 
-uint8_t DS3231_Simple::getTemperature()
+float DS3231_Simple::getTemperatureFloat(const Snapshot &Snap)
 {
-  rtc_i2c_seek(0x11);
+  return getTemperatureQuarters(Snap) * 0.25;
+}
 
-  uint8_t t = 0;
-  uint8_t x = 0;
-  if(Wire.requestFrom(RTC_ADDRESS,(uint8_t) 2) == 2)
-  {
-    t = Wire.read();
-    
-    // The last 2 bits are the number of 0.25 degree units above
-    // the whole degree, we will implement "Bankers Rounding"
-    // such that 0.5 (.25 * 2) is rounded to the nearest even number
-    x = (Wire.read() >> 6);
-    
-    if( (x > 2) || (( x == 2 ) && (t & 0x01)))
-    {      
-      t++;    
-    }
-  }
-  return t;
+
+
+
+
+// Each of the print functions renders into a buffer on the stack and then writes it 
+// in one go, rather than a print() per field and separator, which on a UART or 
+// network Stream can be a separate write each.
+
+char *DS3231_Simple::format_zero_padded(char *Buffer, uint8_t x)
+{
+  *Buffer++ = '0' + x / 10;
+  *Buffer++ = '0' + x % 10;
+  return Buffer;
 }
 
-float DS3231_Simple::getTemperatureFloat()
+char *DS3231_Simple::format_year(char *Buffer, uint8_t Year)
+{
+  *Buffer++ = '2';
+  *Buffer++ = Year >= 100 ? '1' : '0';
+  return format_zero_padded(Buffer, Year % 100);
+}
+
+char *DS3231_Simple::format_12_hour(char *Buffer, uint8_t Hour)
 {
-  rtc_i2c_seek(0x11);
+  if(Hour > 12)  Hour -= 12;
+  if(Hour == 0)  Hour  = 12; // Handle 0 hour = 12 as well
+  if(Hour >= 10) *Buffer++ = '1';
+  *Buffer++ = '0' + Hour % 10;
+  return Buffer;
+}
+
+char *DS3231_Simple::format_am_pm(char *Buffer, uint8_t Hour)
+{
+  *Buffer++ = Hour >= 12 ? 'P' : 'A';
+  *Buffer++ = 'M';
+  return Buffer;
+}
 
-  float t = 0;
-  if(Wire.requestFrom(RTC_ADDRESS,(uint8_t) 2) == 2)
+uint8_t DS3231_Simple::formatTo(char *Buffer, uint8_t Size, const DateTime &Timestamp, const __FlashStringHelper *Format)
+{
+  const char *f = (const char *) Format;
+  char        c;
+  char        Field[4];
+  char       *End;
+  uint8_t     Length = 0;
+  
+  if(!Size) return 0;
+  
+  while((c = pgm_read_byte(f++)))
   {
-    t = Wire.read();
-    t += (Wire.read() >> 6) * 0.25;
+    End = Field;
+    
+    if(c == '%' && (c = pgm_read_byte(f)))
+    {
+      f++;
+      switch(c)
+      {
+        case 'Y': End = format_year(Field, Timestamp.Year);           break;
+        case 'y': End = format_zero_padded(Field, Timestamp.Year % 100); break;
+        case 'm': End = format_zero_padded(Field, Timestamp.Month);   break;
+        case 'd': End = format_zero_padded(Field, Timestamp.Day);     break;
+        case 'H': End = format_zero_padded(Field, Timestamp.Hour);    break;
+        case 'I': End = format_zero_padded(Field, ((Timestamp.Hour + 11) % 12) + 1); break;
+        case 'l': End = format_12_hour(Field, Timestamp.Hour);        break;
+        case 'M': End = format_zero_padded(Field, Timestamp.Minute);  break;
+        case 'S': End = format_zero_padded(Field, Timestamp.Second);  break;
+        case 'p': End = format_am_pm(Field, Timestamp.Hour);          break;
+        case 'u': *End++ = '0' + Timestamp.Dow;                       break;
+        default:  *End++ = c;                                         break; // Including %%
+      }
+    }
+    else
+    {
+      *End++ = c;
+    }
+    
+    for(char *x = Field; x < End; x++)
+    {
+      if(Length + 1 >= Size) break;
+      Buffer[Length++] = *x;
+    }
   }
   
-  return t;
+  Buffer[Length] = 0;
+  return Length;
 }
 
-
-
-
+void DS3231_Simple::printTo(Stream &Printer, const DateTime &Timestamp, const __FlashStringHelper *Format)
+{
+  char Buffer[32];
+  Printer.write((const uint8_t *) Buffer, formatTo(Buffer, sizeof(Buffer), Timestamp, Format));
+}
 
 void DS3231_Simple::printTo(Stream &Printer)
 {
@@ -629,73 +2912,82 @@ void DS3231_Simple::printTo(Stream &Printer)
 
 void DS3231_Simple::printTo(Stream &Printer, const DateTime &timestamp)
 {
-  printDateTo_YMD(Printer, timestamp);
-  Printer.print('T');
-  printTimeTo_HMS(Printer, timestamp);
+  char  Buffer[19];
+  char *End = Buffer;
+  
+  End    = format_year(End, timestamp.Year);
+  *End++ = '-';
+  End    = format_zero_padded(End, timestamp.Month);
+  *End++ = '-';
+  End    = format_zero_padded(End, timestamp.Day);
+  *End++ = 'T';
+  End    = format_zero_padded(End, timestamp.Hour);
+  *End++ = ':';
+  End    = format_zero_padded(End, timestamp.Minute);
+  *End++ = ':';
+  End    = format_zero_padded(End, timestamp.Second);
+  
+  Printer.write((const uint8_t *) Buffer, End - Buffer);
 }
 
 void DS3231_Simple::printDateTo_DMY(Stream &Printer, const DateTime &Timestamp, const char separator)
 {  
-  print_zero_padded(Printer, Timestamp.Day);
-  Printer.print(separator);
-  print_zero_padded(Printer, Timestamp.Month);  
-  Printer.print(separator);
-  if(Timestamp.Year > 100)
-  {
-    Printer.print('2');
-  }
-  else
-  {
-    Printer.print(F("20"));
-  }
-  print_zero_padded(Printer, Timestamp.Year); 
+  char  Buffer[10];
+  char *End = Buffer;
+  
+  End    = format_zero_padded(End, Timestamp.Day);
+  *End++ = separator;
+  End    = format_zero_padded(End, Timestamp.Month);
+  *End++ = separator;
+  End    = format_year(End, Timestamp.Year);
+  
+  Printer.write((const uint8_t *) Buffer, End - Buffer);
 }
 
 void DS3231_Simple::printDateTo_MDY(Stream &Printer, const DateTime &Timestamp, const char separator)
 {  
-  print_zero_padded(Printer, Timestamp.Month);  
-  Printer.print(separator);
-  print_zero_padded(Printer, Timestamp.Day);
-  Printer.print(separator);
-  if(Timestamp.Year > 100)
-  {
-    Printer.print('2');
-  }
-  else
-  {
-    Printer.print(F("20"));
-  }
-  print_zero_padded(Printer, Timestamp.Year); 
+  char  Buffer[10];
+  char *End = Buffer;
+  
+  End    = format_zero_padded(End, Timestamp.Month);
+  *End++ = separator;
+  End    = format_zero_padded(End, Timestamp.Day);
+  *End++ = separator;
+  End    = format_year(End, Timestamp.Year);
+  
+  Printer.write((const uint8_t *) Buffer, End - Buffer);
 }
 
 void DS3231_Simple::printDateTo_YMD(Stream &Printer, const DateTime &Timestamp, const char separator)
 {  
-  if(Timestamp.Year > 100)
-  {
-    Printer.print('2');
-  }
-  else
-  {
-    Printer.print(F("20"));
-  }
-  print_zero_padded(Printer, Timestamp.Year); 
-  Printer.print(separator);
-  print_zero_padded(Printer, Timestamp.Month);  
-  Printer.print(separator);
-  print_zero_padded(Printer, Timestamp.Day);  
+  char  Buffer[10];
+  char *End = Buffer;
+  
+  End    = format_year(End, Timestamp.Year);
+  *End++ = separator;
+  End    = format_zero_padded(End, Timestamp.Month);
+  *End++ = separator;
+  End    = format_zero_padded(End, Timestamp.Day);
+  
+  Printer.write((const uint8_t *) Buffer, End - Buffer);
 }
     
 void DS3231_Simple::printTimeTo_HMS(Stream &Printer, const DateTime &Timestamp, const char hoursToMinutesSeparator , const char minutesToSecondsSeparator )
 {
-  print_zero_padded(Printer, Timestamp.Hour);
-  Printer.print(hoursToMinutesSeparator);
-  print_zero_padded(Printer, Timestamp.Minute);
+  char  Buffer[8];
+  char *End = Buffer;
+  
+  End    = format_zero_padded(End, Timestamp.Hour);
+  *End++ = hoursToMinutesSeparator;
+  End    = format_zero_padded(End, Timestamp.Minute);
   
   if(minutesToSecondsSeparator != 0x03)
   {
-    Printer.print(minutesToSecondsSeparator);
-    print_zero_padded(Printer, Timestamp.Second);    
+    *End++ = minutesToSecondsSeparator;
+    End    = format_zero_padded(End, Timestamp.Second);
   }
+  
+  Printer.write((const uint8_t *) Buffer, End - Buffer);
 }
 
 
@@ -707,32 +2999,23 @@ void DS3231_Simple::printTimeTo_HM (Stream &Printer, const DateTime &Timestamp,
 
 void DS3231_Simple::print12HourTimeTo_HMS(Stream &Printer, const DateTime &Timestamp, const char hoursToMinutesSeparator , const char minutesToSecondsSeparator )
 {
-  if(Timestamp.Hour > 12) 
-  {
-    Printer.print(Timestamp.Hour-12);    
-  }
-  else
-  {
-    Printer.print(Timestamp.Hour ? Timestamp.Hour : 12); // Handle 0 hour = 12 as well    
-  }
+  char  Buffer[11];
+  char *End = Buffer;
   
-  Printer.print(hoursToMinutesSeparator);
-  print_zero_padded(Printer, Timestamp.Minute);
+  End    = format_12_hour(End, Timestamp.Hour);
+  *End++ = hoursToMinutesSeparator;
+  End    = format_zero_padded(End, Timestamp.Minute);
   
   if(minutesToSecondsSeparator != 0x03)
   {
-    Printer.print(minutesToSecondsSeparator);
-    print_zero_padded(Printer, Timestamp.Second);    
-  }
-
-  if(Timestamp.Hour > 12)
-  {
-    Printer.print(F(" PM"));
+    *End++ = minutesToSecondsSeparator;
+    End    = format_zero_padded(End, Timestamp.Second);
   }
-  else
-  {
-    Printer.print(F(" AM"));   
-  }  
+  
+  *End++ = ' ';
+  End    = format_am_pm(End, Timestamp.Hour);
+  
+  Printer.write((const uint8_t *) Buffer, End - Buffer);
 }
 
 void DS3231_Simple::print12HourTimeTo_HM (Stream &Printer, const DateTime &Timestamp, const char hoursToMinutesSeparator )
@@ -740,6 +3023,41 @@ void DS3231_Simple::print12HourTimeTo_HM (Stream &Printer, const DateTime &Times
   print12HourTimeTo_HMS(Printer, Timestamp, hoursToMinutesSeparator, 0x03);
 }
 
+#ifdef USE_STATISTICS
+void DS3231_Simple::resetStatistics()
+{
+  memset(statistics.Api, 0, sizeof(statistics.Api));
+}
+
+void DS3231_Simple::printStats(Stream &Printer)
+{
+  static const char Names[] PROGMEM = "Read\0Write\0Alarms\0Temp\0WriteLog\0ReadLog\0Format\0Other";
+  const char *Name = Names;
+  
+  Printer.println(F("API\tCalls\tI2C\tBytes\tNACKs\tPolls\tRetries\t<250uS\t<1mS\t<4mS\t<16mS\t<64mS\tLonger"));
+  
+  for(uint8_t x = 0; x < STATS_APIS; x++)
+  {
+    const ApiStatistics &Api = statistics.Api[x];
+    
+    Printer.print((const __FlashStringHelper *) Name);
+    Name += strlen_P(Name) + 1;
+    
+    Printer.print('\t'); Printer.print(Api.Calls);
+    Printer.print('\t'); Printer.print(Api.Transactions);
+    Printer.print('\t'); Printer.print(Api.Bytes);
+    Printer.print('\t'); Printer.print(Api.Nacks);
+    Printer.print('\t'); Printer.print(Api.Polls);
+    Printer.print('\t'); Printer.print(Api.Retries);
+    for(uint8_t y = 0; y < STATS_LATENCY_BUCKETS; y++)
+    {
+      Printer.print('\t'); Printer.print(Api.Latency[y]);
+    }
+    Printer.println();
+  }
+}
+#endif
+
 void DS3231_Simple::promptForTimeAndDate(Stream &Serial)
 {
   char buffer[3] = { 0 };
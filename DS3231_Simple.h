@@ -39,6 +39,200 @@
 #define _BV(b) (1UL << (b))
 #endif
 
+// Uncomment to reserve the top 8 pages of the EEPROM (256 bytes of an AT24C32) as a 
+// "superblock" which checkpoints the log read and write positions, after a reset the first
+// writeLog()/readLog() can then pick up from the checkpoint instead of searching the entire 
+// EEPROM.  Each checkpoint goes in the next of the 8 pages, so they share the wear.
+// 
+// This changes the EEPROM layout, formatEEPROM() after changing it.
+// #define USE_LOG_SUPERBLOCK
+
+// Uncomment to use the "sequenced" log format, each EEPROM page is stamped with a sequence
+// number when it is started, so the ordering of log entries does not depend on their 
+// timestamps (setting the clock backwards is fine), and the newest and oldest entries
+// are found by a binary search of the pages instead of reading the entire EEPROM.
+// Entries do not cross a page boundary, so a little space is lost at the end of pages.
+//
+// This changes the EEPROM layout, formatEEPROM() after changing it.  The superblock
+// is not needed (nor supported) with this format.
+// #define USE_SEQUENCED_LOG
+
+// The EEPROM used for logging.  The common ZS-042 modules have an AT24C32 (32 kbit, 32 byte 
+// pages, at 0x57), if you have replaced it with a bigger part, or have a different board,
+// define its size in kbit, page size in bytes and I2C address here (or in your build flags), 
+// for example an AT24C256 is 256 kbit with 64 byte pages, an AT24C512 is 512 kbit with 128 byte pages.  
+// Parts from the AT24C32 to the AT24C512 are supported.
+//
+// This changes the EEPROM layout, formatEEPROM() after changing it.
+// #define DS3231_EEPROM_SIZE_KBIT   32
+// #define DS3231_EEPROM_PAGE_SIZE   32
+// #define DS3231_EEPROM_ADDRESS     0x57
+
+#ifndef DS3231_EEPROM_SIZE_KBIT
+#define DS3231_EEPROM_SIZE_KBIT   32
+#endif
+
+#ifndef DS3231_EEPROM_PAGE_SIZE
+#define DS3231_EEPROM_PAGE_SIZE   32
+#endif
+
+#ifndef DS3231_EEPROM_ADDRESS
+#define DS3231_EEPROM_ADDRESS     0x57
+#endif
+
+#if DS3231_EEPROM_SIZE_KBIT < 32 || DS3231_EEPROM_SIZE_KBIT > 512 || (DS3231_EEPROM_SIZE_KBIT & (DS3231_EEPROM_SIZE_KBIT - 1))
+#error "DS3231_EEPROM_SIZE_KBIT must be one of 32, 64, 128, 256 or 512."
+#endif
+
+#if DS3231_EEPROM_PAGE_SIZE < 16 || DS3231_EEPROM_PAGE_SIZE > 128 || (DS3231_EEPROM_PAGE_SIZE & (DS3231_EEPROM_PAGE_SIZE - 1))
+#error "DS3231_EEPROM_PAGE_SIZE must be one of 16, 32, 64 or 128."
+#endif
+
+#if defined(USE_SEQUENCED_LOG) && defined(USE_LOG_SUPERBLOCK)
+#error "USE_SEQUENCED_LOG and USE_LOG_SUPERBLOCK can not be used together."
+#endif
+
+// Uncomment to make writeLog()/writeLogs() return straight away, without waiting for the 
+// EEPROM.  Entries are queued in RAM (DS3231_LOG_QUEUE_LENGTH of them) and written out a 
+// step at a time by calling serviceLog() from your loop(), no call waits for the EEPROM
+// to finish a page write (which takes it up to 5mS).  Call findLogAddresses() in setup(),
+// finding the log in the EEPROM is the one thing serviceLog() can't do a step at a time.
+//
+// This costs about 200 bytes of RAM on AVR for the queue and the pending page writes.
+// #define USE_ASYNC_LOG
+// #define DS3231_LOG_QUEUE_LENGTH   4
+
+#ifndef DS3231_LOG_QUEUE_LENGTH
+#define DS3231_LOG_QUEUE_LENGTH   4
+#endif
+
+// How long (mS) to wait for the EEPROM to finish a page write (datasheet says 5mS at most)
+// before giving up on it, so that a missing or faulty EEPROM can't hang us forever.
+#ifndef DS3231_EEPROM_WRITE_TIMEOUT
+#define DS3231_EEPROM_WRITE_TIMEOUT 20
+#endif
+
+// Uncomment to be able to queue clock operations (reading or setting the time, setting and
+// checking alarms, measuring the temperature) with requestRead() and friends, they are then
+// done one at a time by calling serviceRequests() from your loop(), which calls a function 
+// you give with the result.  Nothing waits for a temperature measurement (up to 200mS).
+// Up to DS3231_REQUEST_QUEUE_LENGTH requests can be queued, each costs 14 bytes of RAM on AVR.
+//
+// Log writes are queued with USE_ASYNC_LOG, the two can be used together.
+// #define USE_ASYNC_REQUESTS
+// #define DS3231_REQUEST_QUEUE_LENGTH 4
+
+#ifndef DS3231_REQUEST_QUEUE_LENGTH
+#define DS3231_REQUEST_QUEUE_LENGTH 4
+#endif
+
+// Uncomment (as well as USE_ASYNC_REQUESTS) to share a clock between tasks, as on the ESP32
+// with FreeRTOS.  One task owns the clock, it calls begin() and serviceRequests(), and is 
+// the only one which calls anything else that uses the I2C bus.  Any task can queue requests
+// (requestRead(), requestLog() and so on) without locking, and readShared() gives any task
+// the time without using the bus or waiting, from the last the owner read.
+//
+// The queue length must be a power of 2 for this.  Needs the GCC __atomic builtins, which 
+// the ESP32, ESP8266 and ARM cores have (AVR does not, and has no tasks anyway).
+// #define USE_THREAD_SAFE_REQUESTS
+
+#if defined(USE_THREAD_SAFE_REQUESTS) && !defined(USE_ASYNC_REQUESTS)
+#error "USE_THREAD_SAFE_REQUESTS needs USE_ASYNC_REQUESTS too."
+#endif
+
+#if defined(USE_THREAD_SAFE_REQUESTS) && (DS3231_REQUEST_QUEUE_LENGTH & (DS3231_REQUEST_QUEUE_LENGTH - 1))
+#error "DS3231_REQUEST_QUEUE_LENGTH must be a power of 2 for USE_THREAD_SAFE_REQUESTS."
+#endif
+
+// Uncomment to have read() (and so the print functions, setAlarm(mode) and so on) use a copy
+// of the time in RAM, counted on with millis(), instead of reading the clock every time.  
+// The clock is only read again every DS3231_CLOCK_RESYNC_INTERVAL mS, to correct for 
+// millis() not being very accurate, especially with a ceramic resonator as on the Uno, 
+// so the time may change up to a second after the clock does.
+//
+// For the time to change at exactly the same moment as the clock, connect SQW to an 
+// interrupt pin and use enableTick() with the 1Hz rate (or call tick() from your own 
+// interrupt on the FALLING edge).
+// #define USE_CACHED_CLOCK
+// #define DS3231_CLOCK_RESYNC_INTERVAL 10000
+
+#ifndef DS3231_CLOCK_RESYNC_INTERVAL
+#define DS3231_CLOCK_RESYNC_INTERVAL 10000
+#endif
+
+// Uncomment to be able to schedule jobs (functions to call) at a time, or every so many
+// seconds, with scheduleAt()/scheduleEvery().  Alarm 1 is always set for the next job 
+// due, so you can sleep until the alarm pulls SQW low and then call runJobs(), rather
+// than waking every second.  Up to DS3231_SCHEDULER_JOBS jobs at a time, each costs 
+// 11 bytes of RAM on AVR.
+//
+// The scheduler uses Alarm 1, don't set it yourself (Alarm 2 is still yours).
+// #define USE_SCHEDULER
+// #define DS3231_SCHEDULER_JOBS     8
+
+#ifndef DS3231_SCHEDULER_JOBS
+#define DS3231_SCHEDULER_JOBS     8
+#endif
+
+// The I2C bus the clock is on, and the one the EEPROM is on, both Wire unless you define
+// them here (or in your build flags).  If your board has more than one bus you can for
+// example put the clock on Wire1 at 400kHz (call Wire1.setClock() after begin()) and 
+// leave the EEPROM on Wire.
+// #define DS3231_WIRE               Wire
+// #define DS3231_EEPROM_WIRE        Wire
+
+// Uncomment to instead choose the buses, and the EEPROM address, for each DS3231_Simple
+// with setWire(), so that one sketch can drive several clocks and EEPROMs.  The clock's
+// address can not be changed, so each clock needs a bus of its own, EEPROMs can share.
+// 
+// This costs a little flash, and 5 bytes of RAM on AVR for each DS3231_Simple.
+// #define USE_SELECTABLE_WIRE
+
+#ifndef DS3231_WIRE
+#define DS3231_WIRE               Wire
+#endif
+
+#ifndef DS3231_EEPROM_WIRE
+#define DS3231_EEPROM_WIRE        DS3231_WIRE
+#endif
+
+// recoverBus() must take SDA and SCL back from the I2C hardware with Wire.end() before
+// it can clock them itself.  The cores known to have end() (AVR, SAMD, ESP32) use it, 
+// define this as 1 or 0 to say whether yours does.
+// #define DS3231_WIRE_HAS_END       1
+
+#ifndef DS3231_WIRE_HAS_END
+#if defined(WIRE_HAS_END) || defined(ARDUINO_ARCH_AVR) || defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_ARCH_ESP32)
+#define DS3231_WIRE_HAS_END       1
+#else
+#define DS3231_WIRE_HAS_END       0
+#endif
+#endif
+
+// Uncomment to count the I2C traffic of each kind of operation (reading the time, writing 
+// the log and so on), the transactions, bytes, NACKs and EEPROM write polls, and how long 
+// the calls took, see getStatistics() and printStats().  
+//
+// This costs about 250 bytes of RAM and some flash, use it to find where the time (and 
+// power) goes, then turn it off again.
+// #define USE_STATISTICS
+
+// A transaction with the clock or the EEPROM which is not acknowledged, or reads short, is
+// tried again up to DS3231_I2C_RETRIES more times, waiting DS3231_I2C_RETRY_DELAY uS before
+// the first retry and doubling that each time after.  A transaction which succeeds costs 
+// nothing extra.  Set the retries to 0 to never try again, the error is still reported,
+// see getLastError().
+// #define DS3231_I2C_RETRIES        2
+// #define DS3231_I2C_RETRY_DELAY    100
+
+#ifndef DS3231_I2C_RETRIES
+#define DS3231_I2C_RETRIES        2
+#endif
+
+#ifndef DS3231_I2C_RETRY_DELAY
+#define DS3231_I2C_RETRY_DELAY    100
+#endif
+
 class DS3231_Simple
 {
   public:
@@ -71,6 +265,26 @@ class DS3231_Simple
       uint8_t Year;      // 0-199 = 8 bits                  
     };
     #endif
+    
+    /** Seconds since 2000-01-01 00:00:00, see toEpoch() and fromEpoch().
+     *  
+     *  Being just a number you can add, subtract and compare them directly.
+     */
+     
+    typedef uint32_t Epoch;
+    
+    /** Everything snapshot() reads from the clock in one go.
+     */
+     
+    struct Snapshot
+    {
+      DateTime Time;
+      uint8_t  Control;          // Register 0x0E
+      uint8_t  Status;           // Register 0x0F
+      uint8_t  Alarms;           // Alarm flags, as checkAlarms() would return
+      uint8_t  TemperatureMSB;   // Register 0x11, whole degrees (two's complement)
+      uint8_t  TemperatureLSB;   // Register 0x12, top 2 bits are quarter degrees
+    };
 
     
     
@@ -81,10 +295,157 @@ class DS3231_Simple
       
     static uint8_t bcd2bin(uint8_t binaryRepresentation);
     static uint8_t bin2bcd(uint8_t bcdRepresentation);
-    static uint8_t rtc_i2c_seek(const uint8_t Address);
-    static uint8_t rtc_i2c_write_byte(const uint8_t Address, const uint8_t Byte);    
-    static uint8_t rtc_i2c_read_byte(const uint8_t Address,  uint8_t &Byte);    
+    uint8_t rtc_i2c_write_byte(const uint8_t Address, const uint8_t Byte);    
+    uint8_t rtc_i2c_read_byte(const uint8_t Address,  uint8_t &Byte);    
+    
+    /** Start reading Count registers from Address, leaving them waiting in Wire.
+     *  
+     *  Retried as described at DS3231_I2C_RETRIES.
+     *  
+     *  @return Success (boolean) 1/0, on failure lastError says why
+     */
+     
+    uint8_t rtc_i2c_read(const uint8_t Address, const uint8_t Count);
+    
+    /** Write Length bytes to the registers starting at Address.
+     *  
+     *  Retried as described at DS3231_I2C_RETRIES.
+     *  
+     *  @return Success (boolean) 1/0, on failure lastError says why
+     */
+     
+    uint8_t rtc_i2c_write(const uint8_t Address, const uint8_t *Data, const uint8_t Length);
+    
+    /** Decide if a failed transaction should be tried again, waiting before it if so.
+     *  
+     *  @param  Error   The reason it failed, kept in lastError if we give up.
+     *  @param  Attempt The retries made so far, incremented here.
+     *  @return 1 to try again, 0 to give up
+     */
+     
+    uint8_t retryI2C(const uint8_t Error, uint8_t &Attempt);
+    
+    /** Restart the oscillator after checkAlarms() paused it (clear EOSC).
+     *  
+     *  @return 1 if restarted, 0 if not (and clockPaused stays set so that the next 
+     *    checkAlarms() tries again)
+     */
+     
+    uint8_t resumeClock();
+    
+    uint8_t lastError    = 0;   // ERROR_NONE etc, see getLastError()
+    uint8_t eepromFailed = 0;   // The EEPROM gave up part way through the current operation
+    uint8_t clockPaused  = 0;   // checkAlarms() set EOSC and has not been able to clear it yet
+    
     static void    print_zero_padded(Stream &Printer, uint8_t x);    
+    static char   *format_zero_padded(char *Buffer, uint8_t x);
+    static char   *format_year(char *Buffer, uint8_t Year);
+    static char   *format_12_hour(char *Buffer, uint8_t Hour);
+    static char   *format_am_pm(char *Buffer, uint8_t Hour);
+    
+    /** Read the date and time from the clock itself.
+     *  
+     *  @return Success (boolean) 1/0
+     */
+     
+    uint8_t  readClock(DateTime &currentDate);
+    
+    /** Decode the 7 time registers from Wire into the given DateTime.
+     */
+     
+    void readClockRegisters(DateTime &currentDate);
+    
+    /** Decode the temperature registers to quarter degrees.
+     */
+     
+    static int16_t decodeTemperature(const uint8_t MSB, const uint8_t LSB);
+    
+    /** Round quarter degrees to whole degrees.
+     */
+     
+    static int8_t  roundTemperature(const int16_t Quarters);
+    
+    #ifdef USE_SELECTABLE_WIRE
+    TwoWire                  *rtcWire       = &DS3231_WIRE;
+    TwoWire                  *eepromWire    = &DS3231_EEPROM_WIRE;
+    uint8_t                   eepromAddress = DS3231_EEPROM_ADDRESS;
+    #endif
+    
+    uint8_t                   registerShadow[8];                                // Copy of the alarm and control registers, 0x07 to 0x0E
+    uint8_t                   registerShadowValid = 0;
+    uint8_t                   temperatureConverting = 0;                        // startTemperatureConversion() not yet seen done
+    
+    #ifdef USE_SCHEDULER
+    struct Job
+    {
+      Epoch    Due;
+      uint32_t Interval;                                                        // Seconds, 0 for once only
+      void   (*Callback)();                                                     // NULL for an unused slot
+    };
+    
+    Job                       jobs[DS3231_SCHEDULER_JOBS] = {};
+    uint8_t                   jobHeap[DS3231_SCHEDULER_JOBS];                   // Indexes into jobs, a min-heap on Due
+    uint8_t                   jobCount   = 0;
+    uint8_t                   jobRunning = 0;                                   // Index + 1 of the job being called, 0 for none
+    
+    void     pushJob(const uint8_t Index);
+    void     removeJob(const uint8_t HeapPosition);
+    void     siftJobUp(uint8_t HeapPosition);
+    void     siftJobDown(uint8_t HeapPosition);
+    
+    /** Set Alarm 1 for the next job due (or never if there are none).
+     */
+     
+    uint8_t  armJobAlarm();
+    #endif
+    
+    /** Read a register, from our copy for the alarm and control registers.
+     *  
+     *  @return Success (boolean) 1/0
+     */
+     
+    uint8_t  readRegister(const uint8_t Address, uint8_t &Data);
+    
+    /** Write registers, unless our copy shows they already have this data.
+     *  
+     *  @return Success (boolean) 1/0
+     */
+     
+    uint8_t  writeRegisters(const uint8_t Address, const uint8_t *Data, const uint8_t Length);
+    uint8_t  writeRegister(const uint8_t Address, const uint8_t Data);
+    
+    /** Number of days in the given month (1-12) of the given year (0-199).
+     */
+     
+    static uint8_t daysInMonth(const uint8_t Year, const uint8_t Month);
+    
+    #ifdef USE_CACHED_CLOCK
+    DateTime                  clockCache;                                       // The time at clockCacheMillis
+    unsigned long             clockCacheMillis = 0;                             // millis() at (as near as we know) the start of that second
+    unsigned long             clockSyncMillis  = 0;                             // millis() when we last read the clock
+    uint8_t                   clockCacheValid  = 0;
+    uint8_t                   clockCacheEdges  = 0;                             // clockEdges already counted into clockCache
+    
+    volatile unsigned long    clockEdgeMillis  = 0;                             // millis() at the last tick()
+    volatile uint8_t          clockEdges       = 0;                             // Count of tick()
+    
+    /** Read the clock into the clockCache.
+     *  
+     *  @return Success (boolean) 1/0, on failure the clockCache is left as it was
+     */
+     
+    uint8_t  syncClock();
+    #endif
+    
+    volatile uint32_t         tickCount        = 0;
+    uint32_t                  tickCountSeen    = 0;                             // tickCount at the last ticked()
+    void                   (* volatile tickCallback)() = NULL;
+    uint8_t                   tickPin          = 0;
+    uint8_t                   squareWaveRate   = SQW_OFF;                       // What tick() is counting
+    static const uint8_t      SQW_OFF          = 0xFF;                          // squareWaveRate while INTCN is set (no square wave)
+    
+    static DS3231_Simple     *tickClock;                                        // Who the tick interrupt is for
+    static void               tickInterrupt();
           
   public:
     /* 
@@ -125,24 +486,181 @@ class DS3231_Simple
     static const uint8_t ALARM_WEEKLY                          = 0B00001011;
     static const uint8_t ALARM_MONTHLY                         = 0B00000011;  
     
+    static const uint8_t BEGIN_COLD                            = 0;
+    static const uint8_t BEGIN_WARM                            = 1;
+    
     /** Initialize.
      *  
+     *  BEGIN_COLD (the default) sets the clock up from scratch, oscillator on, no
+     *  square wave (SQW is left for the alarms, see enableSquareWave()), and both 
+     *  alarms disabled.
+     *  
+     *  BEGIN_WARM is for when the clock has already been set up, for example when 
+     *  waking from deep sleep.  It reads the alarm, control and status registers 
+     *  in one go and, as long as the oscillator has not stopped, leaves the square 
+     *  wave and any alarms as they are, only starting the oscillator if it was 
+     *  turned off.  If the oscillator has stopped since the time was last set with
+     *  write() (or it never has been) it does a cold start instead.
+     *  
+     *  @param Mode BEGIN_COLD or BEGIN_WARM
+     *  @return For BEGIN_WARM, 1 if the clock was still set up and running, 0 if it 
+     *    needed a cold start (so the time is probably wrong too).  For BEGIN_COLD, 
+     *    1, or 0 if the clock could not be set up (see getLastError()).
+     */
+     
+    uint8_t begin(const uint8_t Mode = BEGIN_COLD);
+    
+    #ifdef USE_SELECTABLE_WIRE
+    /** Choose the I2C buses for this clock and its EEPROM, call before begin().
+     *  
+     *  For example, two clocks on separate buses sharing one EEPROM bus
+     *  
+     *    ClockA.setWire(Wire,  Wire);
+     *    ClockB.setWire(Wire1, Wire, 0x56);
+     *  
+     *  @param RtcWire    The bus the clock is on
+     *  @param EepromWire The bus the EEPROM is on
+     *  @param EepromAddress The EEPROM's address, see EEPROM_ADDRESS
+     */
+     
+    void    setWire(TwoWire &RtcWire, TwoWire &EepromWire, const uint8_t EepromAddress = DS3231_EEPROM_ADDRESS);
+    #endif
+    
+    // Why the last I2C transaction failed, see getLastError(), the first 5 are Wire's own
+    static const uint8_t ERROR_NONE                            = 0;
+    static const uint8_t ERROR_TOO_LONG                        = 1;   // Too much for Wire's buffer
+    static const uint8_t ERROR_ADDRESS_NACK                    = 2;   // Nobody answered, not connected?
+    static const uint8_t ERROR_DATA_NACK                       = 3;   // Answered but then refused the data
+    static const uint8_t ERROR_OTHER                           = 4;   // Lost arbitration, bus error etc
+    static const uint8_t ERROR_TIMEOUT                         = 5;   // The bus was held, try recoverBus()
+    static const uint8_t ERROR_SHORT_READ                      = 6;   // Got fewer bytes than asked for
+    static const uint8_t ERROR_EEPROM_TIMEOUT                  = 7;   // The EEPROM never finished a page write
+    
+    /** Why the last I2C transaction to fail (after the retries, see DS3231_I2C_RETRIES) did so.
+     *  
+     *  Use it when a function returns 0 to tell a missing or misbehaving clock or EEPROM from 
+     *  an empty log and the like.  Reading it clears it back to ERROR_NONE.
+     *  
+     *  @return ERROR_NONE, ERROR_ADDRESS_NACK etc
+     */
+     
+    uint8_t getLastError() { uint8_t Error = lastError; lastError = ERROR_NONE; return Error; }
+    
+    /** Try to free the I2C bus when a device is holding SDA low, for example because 
+     *  the Arduino was reset part way through reading from it.
+     *  
+     *  Ends Wire (see DS3231_WIRE_HAS_END) so the pins are free, clocks SCL (up to 9 
+     *  times) until the device lets go of SDA, sends a STOP and then begins Wire again.  
+     *  The pins are needed because Wire does not say which it uses, on an Uno that is 
+     *  recoverBus(SDA, SCL).
+     *  
+     *  @return 1 if SDA is now free, 0 if it is still held (or shorted)
      */
      
-    void begin();
+    uint8_t recoverBus(const uint8_t SdaPin, const uint8_t SclPin);
 
     /** Read the current date and time, returning a structure containing that information.
      *  
+     *  With USE_CACHED_CLOCK this is usually just a copy from RAM, see DS3231_Simple.h
      */
      
     DateTime read();
+    
+    /** Read the current date and time into the given structure.
+     *  
+     *  Unlike read() this tells you if it worked, if the clock could not be read (see 
+     *  getLastError()) the structure is zeroed and 0 returned.  With USE_CACHED_CLOCK 
+     *  it only fails if the clock has never been read successfully.
+     *  
+     *  @return Success (boolean) 1/0
+     */
+     
+    uint8_t  read(DateTime &currentDate);
 
     /** Set the date and time from the settings in the given structure.
+     *  
+     *  Also clears the Oscillator Stop Flag, see begin(BEGIN_WARM).
      *  
      *  @param The date/time
+     *  @return Success (boolean) 1/0, 0 if the time or the flag could not be written
      */
      
     uint8_t  write(const DateTime&);
+    
+    static const uint8_t SQW_1HZ                               = 0B00000000;
+    static const uint8_t SQW_1024HZ                            = 0B00001000;
+    static const uint8_t SQW_4096HZ                            = 0B00010000;
+    static const uint8_t SQW_8192HZ                            = 0B00011000;
+    
+    /** Output a square wave on the SQW pin.  It is off after a cold begin(), which 
+     *  leaves SQW for the alarms, and a warm begin() leaves it as it was.
+     *  
+     *  While the square wave is on the alarms still trigger (see checkAlarms()) 
+     *  but can not pull SQW low, setting an alarm turns the square wave off.
+     *  
+     *  @param Rate One of SQW_1HZ, SQW_1024HZ, SQW_4096HZ, SQW_8192HZ
+     *  @return Success (boolean) 1/0
+     */
+     
+    uint8_t  enableSquareWave(const uint8_t Rate = SQW_1HZ);
+    
+    /** Turn off the square wave so that SQW is used for the alarms again.
+     *  
+     *  @return Success (boolean) 1/0
+     */
+     
+    uint8_t  disableSquareWave();
+    
+    /** Start the square wave and count its ticks (falling edges) with an interrupt 
+     *  on the given pin, connected to SQW.  After this getTicks() and ticked() tell 
+     *  you how many ticks there have been without using I2C at all.
+     *  
+     *  SQW is open-drain, the pin's internal pullup is turned on, for the higher 
+     *  rates you may want a stronger external pullup.
+     *  
+     *  Only one DS3231_Simple can tick at a time.
+     *  
+     *  Example:
+     *    Clock.enableTick(2);
+     *    ...
+     *    if(Clock.ticked())
+     *    {
+     *      // Once a second
+     *    }
+     *  
+     *  @param Pin      Digital pin that SQW is connected to, must be able to interrupt.
+     *  @param Rate     One of SQW_1HZ, SQW_1024HZ, SQW_4096HZ, SQW_8192HZ
+     *  @param Callback Optional function to call on each tick.  It is called from 
+     *                  the interrupt, so keep it short and do not use Wire or Serial.
+     *  
+     *  @return Success (boolean) 1/0
+     */
+     
+    uint8_t  enableTick(const uint8_t Pin, const uint8_t Rate = SQW_1HZ, void (*Callback)() = NULL);
+    
+    /** Stop counting ticks.  The square wave is left running.
+     */
+     
+    void     disableTick();
+    
+    /** Count one tick.  enableTick() does this for you, if you attach your own interrupt
+     *  to the FALLING edge of SQW, call this from it.
+     *  
+     *  With USE_CACHED_CLOCK and the 1Hz rate, each tick starts the next second of the 
+     *  time read() returns, so that it changes at the same moment as the clock.
+     */
+     
+    void     tick();
+    
+    /** The number of ticks so far.
+     */
+     
+    uint32_t getTicks();
+    
+    /** The number of ticks since you last called ticked(), 0 if none.
+     */
+     
+    uint32_t ticked();
 
     void     promptForTimeAndDate(Stream &Serial);
     
@@ -198,46 +716,391 @@ class DS3231_Simple
      *    ALARM_MONTHLY
      */
      
-    uint8_t  setAlarm(uint8_t AlarmMode);    
-
+    uint8_t  setAlarm(uint8_t AlarmMode);    
+
+    
+    /** Disable any existing alarm settings, and clear the alarm flags.             
+     *  
+     *  @return Success True/False, False if any of that could not be written (see
+     *    getLastError()).
+     */
+     
+    uint8_t  disableAlarms();
+    
+    /** Determine if an alarm has triggered, also clears the alarm if so.
+     *  
+     *  If you do not pause the clock then be aware that there is a small chance 
+     *  that you may miss an alarm between the very short time that the alarms 
+     *  are checked and then cleared (ie, if an alarm is checked and is 0, and 
+     *  before we clear it, the alarm is triggered, but then we go and clear it).
+     *  
+     *  If you pause the clock, then this won't happen, but your time keeping
+     *  will not be so accurate because every time you check the alarm you will 
+     *  "get behind" a small amount.
+     * 
+     *  Can be "read only" by disabling the clearing of the alarms. By default
+     *  will clear alarms.
+     *  
+     *  If the status can't be read nothing is cleared and 0 is returned, see 
+     *  getLastError().  If the alarm can't be cleared 0 is returned too, and it
+     *  is still there for the next checkAlarms().  If a paused clock can't be 
+     *  restarted getLastError() says so and the next checkAlarms() tries again first.
+     *  
+     *  @return 0 For no alarm, 1 for Alarm 1, 2 for Alarm 2, and 3 for Both Alarms     
+     */
+     
+    uint8_t  checkAlarms(uint8_t PauseClock = false, uint8_t ClearAlarms = true);
+    
+    /** Determine if an alarm had triggered when the snapshot was taken, and clear
+     *  it if so, without reading the clock again.
+     *  
+     *  If the alarm can't be cleared 0 is returned (see getLastError()), and it 
+     *  is still there for the next checkAlarms().
+     *  
+     *  @return 0 For no alarm, 1 for Alarm 1, 2 for Alarm 2, and 3 for Both Alarms     
+     */
+     
+    uint8_t  checkAlarms(const Snapshot &Snap, uint8_t ClearAlarms = true);
+    
+    #ifdef USE_SCHEDULER
+    /** Call a function at the given time, and optionally every Interval seconds after.
+     *  
+     *  Example:
+     *    void backup() { ... }
+     *    ...
+     *    DateTime Tonight = Clock.read();
+     *    Tonight.Hour = 23; Tonight.Minute = 0; Tonight.Second = 0;
+     *    Clock.scheduleAt(DS3231_Simple::toEpoch(Tonight), backup, 86400);
+     *  
+     *  @param When      Time to call it, see toEpoch().  If that has already passed it 
+     *                   is called at the next runJobs().
+     *  @param Callback  The function, called from runJobs() (not an interrupt).
+     *  @param Interval  Seconds between calls after that, 0 to only call it once.
+     *  
+     *  @return Job number to give to cancelJob(), 0 if there are DS3231_SCHEDULER_JOBS
+     *    jobs already.
+     */
+     
+    uint8_t  scheduleAt(const Epoch When, void (*Callback)(), const uint32_t Interval = 0);
+    
+    /** Call a function every Interval seconds, starting Interval seconds from now.
+     *  
+     *  @return Job number to give to cancelJob(), 0 if there are DS3231_SCHEDULER_JOBS
+     *    jobs already.
+     */
+     
+    uint8_t  scheduleEvery(const uint32_t Interval, void (*Callback)());
+    
+    /** Stop a job, it can be called from the job's own function.
+     *  
+     *  @return 1 if there was such a job, 0 if not
+     */
+     
+    uint8_t  cancelJob(const uint8_t Job);
+    
+    /** Call the functions of all the jobs which are due, then set Alarm 1 for the 
+     *  next.  Call this when Alarm 1 fires (SQW goes low) or just from your loop().
+     *  
+     *  Example:
+     *    // Sleep until the alarm pulls SQW low (wakes an interrupt pin), then
+     *    Clock.runJobs();
+     *  
+     *  @return The number of jobs that were run.
+     */
+     
+    uint8_t  runJobs();
+    
+    /** When the next job is due, see fromEpoch(), 0 if there are no jobs.
+     */
+     
+    Epoch    nextJobDue() { return jobCount ? jobs[jobHeap[0]].Due : 0; }
+    #endif
+
+    /** Get the temperature accurate to within 1 degree (C)
+     *  
+     */
+     
+    int8_t   getTemperature();
+
+    /** Get the temprature accurate to within 0.25 degrees (C)
+     *  
+     *  This brings in floating point, getTemperatureQuarters() or 
+     *  getTemperatureCentidegrees() give you the same without.
+     */
+     
+    float    getTemperatureFloat();
+    
+    /** Get the temperature in quarter degrees (C), for example 25.75 degrees is 103.
+     *  
+     *  This is exactly what the clock measures (a signed 10 bit number), so it is 
+     *  also the most compact way to log it, 2 bytes instead of 4 for a float:
+     *  
+     *    Clock.writeLog(Clock.getTemperatureQuarters());
+     */
+     
+    int16_t  getTemperatureQuarters();
+    
+    /** Get the temperature in hundredths of a degree (C), for example 25.75 degrees is 2575.
+     *  
+     */
+     
+    int16_t  getTemperatureCentidegrees();
+    
+    /** Get the temperature from a snapshot, accurate to within 1 degree (C)
+     *  
+     */
+     
+    int8_t   getTemperature(const Snapshot &Snap);
+    
+    /** Get the temperature from a snapshot, accurate to within 0.25 degrees (C)
+     *  
+     */
+     
+    float    getTemperatureFloat(const Snapshot &Snap);
+    
+    /** Get the temperature from a snapshot in quarter degrees (C).
+     *  
+     */
+     
+    int16_t  getTemperatureQuarters(const Snapshot &Snap);
+    
+    /** Get the temperature from a snapshot in hundredths of a degree (C).
+     *  
+     */
+     
+    int16_t  getTemperatureCentidegrees(const Snapshot &Snap);
+    
+    /** The clock only measures the temperature every 64 seconds by itself, this 
+     *  starts a measurement now.  It does not wait, use temperatureReady() to find 
+     *  out when it's done (about 200mS at most), then getTemperature...() as usual.
+     *  
+     *  If the clock is already in the middle of measuring by itself, that 
+     *  measurement is the one you get.
+     *  
+     *  Example:
+     *    Clock.startTemperatureConversion();
+     *    ...
+     *    if(Clock.temperatureReady())
+     *    {
+     *      Temperature = Clock.getTemperatureQuarters();
+     *    }
+     *  
+     *  @return Success (boolean) 1/0
+     */
+     
+    uint8_t  startTemperatureConversion();
+    
+    /** Is the measurement from startTemperatureConversion() finished (or was there
+     *  none started)?  Each call is a single small I2C read while it is not.
+     *  
+     *  @return 1 if finished, 0 if not yet
+     */
+     
+    uint8_t  temperatureReady();
+    
+    #ifdef USE_ASYNC_REQUESTS
+    static const uint8_t REQUEST_READ         = 1;   // Read the time into Time
+    static const uint8_t REQUEST_WRITE        = 2;   // Set the time to Time
+    static const uint8_t REQUEST_SET_ALARM    = 3;   // Set an alarm for Time, Mode is the alarm mode
+    static const uint8_t REQUEST_CHECK_ALARMS = 4;   // Check (and clear) the alarms, Result as checkAlarms() returns
+    static const uint8_t REQUEST_TEMPERATURE  = 5;   // Measure the temperature, Result in quarter degrees
+    #ifdef USE_THREAD_SAFE_REQUESTS
+    static const uint8_t REQUEST_WRITE_LOG    = 6;   // writeLog() with Time as the timestamp, Mode bytes of Data
+    #endif
+    
+    static const uint8_t REQUESTS_IDLE        = 0;   // Nothing queued
+    static const uint8_t REQUESTS_BUSY        = 1;   // Still some to do, call serviceRequests() again
+    
+    /** A queued clock operation, given to its callback when it is done.
+     */
+     
+    struct Request
+    {
+      uint8_t  Operation;                            // REQUEST_READ etc
+      uint8_t  Mode;                                 // Alarm mode for REQUEST_SET_ALARM
+      DateTime Time;                                 
+      int16_t  Result;
+      uint8_t  Success;                              // 1 if it worked, 0 if not
+      void   (*Callback)(const Request &Done);       // May be NULL
+      #ifdef USE_THREAD_SAFE_REQUESTS
+      uint8_t  Data[7];                              // For REQUEST_WRITE_LOG
+      #endif
+    };
+    
+    typedef void (*RequestCallback)(const Request &Done);
+    
+    /** Queue a read of the time, the callback gets it in Done.Time.
+     *  
+     *  Example:
+     *    void gotTime(const DS3231_Simple::Request &Done)
+     *    {
+     *      if(Done.Success) Clock.printTo(Serial, Done.Time);
+     *    }
+     *    ...
+     *    Clock.requestRead(gotTime);
+     *  
+     *  @return Success (boolean) 1/0, 0 if the queue is full.
+     */
+     
+    uint8_t  requestRead(RequestCallback Callback);
+    
+    /** Queue setting the time, as write().
+     *  
+     *  @return Success (boolean) 1/0, 0 if the queue is full.
+     */
+     
+    uint8_t  requestWrite(const DateTime &Time, RequestCallback Callback = NULL);
+    
+    /** Queue setting an alarm, as setAlarm().
+     *  
+     *  @return Success (boolean) 1/0, 0 if the queue is full.
+     */
+     
+    uint8_t  requestAlarm(const DateTime &AlarmTime, uint8_t AlarmMode, RequestCallback Callback = NULL);
+    
+    /** Queue a checkAlarms(), the callback gets the alarms which fired in Done.Result.
+     *  
+     *  @return Success (boolean) 1/0, 0 if the queue is full.
+     */
+     
+    uint8_t  requestCheckAlarms(RequestCallback Callback);
+    
+    /** Queue a temperature measurement (see startTemperatureConversion()), the 
+     *  callback gets the temperature in quarter degrees in Done.Result.
+     *  
+     *  @return Success (boolean) 1/0, 0 if the queue is full.
+     */
+     
+    uint8_t  requestTemperature(RequestCallback Callback);
+    
+    /** Carry on with the queued requests, call this often (every loop()).
+     *  
+     *  Each call does at most the oldest request (a couple of short I2C transactions, 
+     *  the same as the ordinary function would) and calls its callback, except that a
+     *  temperature measurement is only checked on each call until it is finished.  
+     *  
+     *  Callbacks are called from here (not an interrupt), and may queue more requests.
+     *  
+     *  @return REQUESTS_IDLE or REQUESTS_BUSY
+     */
+     
+    uint8_t  serviceRequests();
+    
+    #ifdef USE_THREAD_SAFE_REQUESTS
+    /** Queue a log entry to be written by the task which owns the clock.
+     *  
+     *  Example:
+     *    DateTime Now;
+     *    if(Clock.readShared(Now)) Clock.requestLog(Now, analogRead(A0));
+     *  
+     *  @param timestamp The timestamp of the entry.
+     *  @param data      Any datatype of not more than 7 bytes.
+     *  @param Callback  Called from serviceRequests() (in the owner's task) when written, may be NULL.
+     *  @return Success (boolean) 1/0, 0 if the queue is full.
+     */
+     
+    template <typename datatype>
+      uint8_t  requestLog( const DateTime &timestamp, const datatype &data, RequestCallback Callback = NULL ) {
+        return requestLog(timestamp, (const uint8_t *) &data, (uint8_t)sizeof(datatype), Callback);
+      }
+    
+    uint8_t  requestLog(const DateTime &timestamp, const uint8_t *data, uint8_t size, RequestCallback Callback);
+    
+    /** Get the time, from any task, without using the bus or waiting.
+     *  
+     *  This is the time the owning task last read from the clock (serviceRequests() 
+     *  reads it every DS3231_CLOCK_RESYNC_INTERVAL mS when it has nothing else to do, 
+     *  and for each requestRead()) counted on with millis().
+     *  
+     *  @param Time Where to put it
+     *  @return 1 if it was known, 0 if the owner has not read the clock yet.
+     */
+     
+    uint8_t  readShared(DateTime &Time);
+    #endif
+    
+  protected:
+    static const uint16_t     REQUEST_TEMPERATURE_TIMEOUT = 1000;               // mS, a measurement takes 200mS at most
+    
+    Request                   requests[DS3231_REQUEST_QUEUE_LENGTH];            // Waiting to be done, oldest at requestHead
+    #ifdef USE_THREAD_SAFE_REQUESTS
+    // A bounded lock free queue for many producers and one consumer.  Position P is in
+    // slot P % DS3231_REQUEST_QUEUE_LENGTH, and requestTurn[slot] + slot is P when the 
+    // slot is free to queue P into, P + 1 once it is queued, and P + the queue length 
+    // when it has been done (so all zero is an empty queue).
+    uint32_t                  requestTurn[DS3231_REQUEST_QUEUE_LENGTH] = {};
+    uint32_t                  requestQueued   = 0;                              // Next position to queue into, any task
+    uint32_t                  requestDone     = 0;                              // Next position to do, the owner only
+    
+    // The time for readShared(), written by the owner only into the copy not in use
+    // [(Sequence + 1) & 1] before moving the sequence on, and read by the others
+    // again if the sequence changed meanwhile, so a reader never waits on the owner.
+    DateTime                  sharedClock[2];
+    unsigned long             sharedClockMillis[2];                             // millis() at sharedClock
+    uint32_t                  sharedClockSequence = 0;                          // 0 until first written
+    
+    /** Make the time read from the clock at Millis the one readShared() gives.
+     */
+     
+    void     shareClock(const DateTime &Time, const unsigned long Millis);
+    #else
+    uint8_t                   requestHead    = 0;
+    uint8_t                   requestCount   = 0;
+    #endif
+    uint8_t                   requestStarted = 0;                               // The oldest request's temperature measurement was started
+    unsigned long             requestMillis  = 0;                               // millis() when it was
+    
+    /** Add a request to the queue.
+     *  
+     *  @return Success (boolean) 1/0
+     */
+     
+    uint8_t  queueRequest(const uint8_t Operation, const DateTime &Time, const uint8_t Mode, RequestCallback Callback, const uint8_t *Data = NULL);
+    
+    /** The oldest request queued, NULL if none.
+     */
+     
+    Request *oldestRequest();
     
-    /** Disable any existing alarm settings.             
-     *  
-     *  @return Success True/False
+    /** Take the oldest request off the queue.
      */
      
-    uint8_t  disableAlarms();
+    void     removeOldestRequest();
     
-    /** Determine if an alarm has triggered, also clears the alarm if so.
+  public:
+    #endif
+    
+    /** Read the time, control and status registers, alarm flags and temperature
+     *  from the clock all at once (registers 0x00 to 0x12 in one I2C read).
      *  
-     *  If you do not pause the clock then be aware that there is a small chance 
-     *  that you may miss an alarm between the very short time that the alarms 
-     *  are checked and then cleared (ie, if an alarm is checked and is 0, and 
-     *  before we clear it, the alarm is triggered, but then we go and clear it).
+     *  Use Snap.Time as you would the result of read() and pass the snapshot to 
+     *  checkAlarms(), getTemperature() or getTemperatureFloat() instead of having
+     *  each of those read the clock themselves.
      *  
-     *  If you pause the clock, then this won't happen, but your time keeping
-     *  will not be so accurate because every time you check the alarm you will 
-     *  "get behind" a small amount.
-     * 
-     *  Can be "read only" by disabling the clearing of the alarms. By default
-     *  will clear alarms.
+     *  Example:
+     *    DS3231_Simple::Snapshot Snap;
+     *    if(Clock.snapshot(Snap))
+     *    {
+     *      Clock.printTo(Serial, Snap.Time);
+     *      Serial.println(Clock.getTemperatureFloat(Snap));
+     *      if(Clock.checkAlarms(Snap)) { ... }
+     *    }
      *  
-     *  @return 0 For no alarm, 1 for Alarm 1, 2 for Alarm 2, and 3 for Both Alarms     
+     *  @return Success (boolean) 1/0
      */
      
-    uint8_t  checkAlarms(uint8_t PauseClock = false, uint8_t ClearAlarms = true);
-
-    /** Get the temperature accurate to within 1 degree (C)
+    uint8_t  snapshot(Snapshot &Snap);
+    
+    /** The alarm and control registers are only read once, after that we 
+     *  keep track of them ourselves and skip writing anything that hasn't changed.
      *  
-     */
-     
-    uint8_t  getTemperature();
-
-    /** Get the temprature accurate to within 0.25 degrees (C)
+     *  If something else might have changed them (another microcontroller on the bus 
+     *  for example), call this to read them again.
      *  
+     *  @return Success (boolean) 1/0
      */
      
-    float    getTemperatureFloat();
+    uint8_t  resyncRegisters();
 
     /** Print the current DateTime structure in ISO8601 Format
      *  
@@ -331,15 +1194,64 @@ class DS3231_Simple
      */    
     void     print12HourTimeTo_HM(Stream &Printer) { print12HourTimeTo_HM(Printer, read()); }
     
+    /** Format the given DateTime into a buffer, strftime() style.
+     *  
+     *    %Y  Year, 4 digits        %H  Hour (24 Hour Clock), 2 digits
+     *    %y  Year, 2 digits        %I  Hour (12 Hour Clock), 2 digits
+     *    %m  Month, 2 digits       %l  Hour (12 Hour Clock), 1 or 2 digits
+     *    %d  Day, 2 digits         %M  Minute, 2 digits
+     *    %u  Day Of Week, 1-7      %S  Second, 2 digits
+     *    %%  A % sign              %p  AM or PM
+     *  
+     *  Anything else is copied as is.  The result is always null terminated, and 
+     *  cut short if the buffer is too small.
+     *  
+     *  Example: 
+     *    char Buffer[20];
+     *    Clock.formatTo(Buffer, sizeof(Buffer), MyTimestamp, F("%Y-%m-%d,%H:%M:%S"));
+     *  
+     *  @param Buffer    Where to put it
+     *  @param Size      sizeof(Buffer)
+     *  @param Timestamp The date/time to format
+     *  @param Format    The format, in flash (F("...")).
+     *  @return The length of the result, not counting the null.
+     */
+     
+    static uint8_t formatTo(char *Buffer, uint8_t Size, const DateTime &Timestamp, const __FlashStringHelper *Format);
+    
+    /** Print the given DateTime structure in the given format (see formatTo()), as a 
+     *  single write to the Stream.  At most 31 characters.
+     *  
+     *  Example: Clock.printTo(Serial, MyTimestamp, F("%d/%m/%Y %l:%M %p"));
+     */
+     
+    void     printTo(Stream &Printer, const DateTime &Timestamp, const __FlashStringHelper *Format);
+    
+    /** Print the current date and time in the given format, see formatTo().
+     *  
+     */
+     
+    void     printTo(Stream &Printer, const __FlashStringHelper *Format) { printTo(Printer, read(), Format); }
+    
   // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
   // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
   // EEPROM LOGGING
   // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
   // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
   
+  public:
+  
+    // An address in the EEPROM, the AT24C512 needs more than 16 bits because the end 
+    // of the EEPROM (65536) is used as "nowhere".
+    #if DS3231_EEPROM_SIZE_KBIT > 256
+    typedef uint32_t          EEPROMAddress;
+    #else
+    typedef uint16_t          EEPROMAddress;
+    #endif
+    
   protected:
   
-    static const uint8_t      EEPROM_ADDRESS   = 0x57;                          
+    static const uint8_t      EEPROM_ADDRESS   = DS3231_EEPROM_ADDRESS;                          
       // 7 Bit address, the first 4 bits are 1010, the the last 3 bits according to A2, A1 and A0
       // On the common ZS-042 board, this corresponds to (where x is jumper open, and 1 is jumper closed)
       // A0    A1    A2
@@ -352,10 +1264,59 @@ class DS3231_Simple
       //  1    1     1    0x51
                                                                                 
                                                                                 
-    static const uint16_t     EEPROM_SIZE_KBIT = 32768;                         // EEPROMs are sized in kilobit
-    static const uint8_t      EEPROM_PAGE_SIZE = 32;                            // And have a number of bytes per page
-    static const uint16_t     EEPROM_BYTES     = EEPROM_SIZE_KBIT/8;            
-    static const uint8_t      EEPROM_PAGES     = EEPROM_BYTES/EEPROM_PAGE_SIZE; 
+    static const uint16_t     EEPROM_SIZE_KBIT = DS3231_EEPROM_SIZE_KBIT;       // EEPROMs are sized in kilobit
+    static const uint8_t      EEPROM_PAGE_SIZE = DS3231_EEPROM_PAGE_SIZE;       // And have a number of bytes per page
+    static const EEPROMAddress EEPROM_BYTES    = EEPROM_SIZE_KBIT*128UL;        
+    static const uint16_t     EEPROM_PAGES     = EEPROM_BYTES/EEPROM_PAGE_SIZE; 
+    
+    // The Wire library can only send or receive as many bytes in one transaction as its buffer 
+    // allows, AVR has 32 bytes (BUFFER_LENGTH), ESP32 and some others have 128 (I2C_BUFFER_LENGTH),
+    // the RP2040 core has 256 (WIRE_BUFFER_SIZE).
+    // Sequential reads of the EEPROM are chunked to this size, capped at 64 because the 
+    // chunk buffer lives on the stack.
+    #if defined(I2C_BUFFER_LENGTH)
+    static const uint16_t     WIRE_BUFFER_LENGTH = I2C_BUFFER_LENGTH;
+    #elif defined(BUFFER_LENGTH)
+    static const uint16_t     WIRE_BUFFER_LENGTH = BUFFER_LENGTH;
+    #elif defined(WIRE_BUFFER_SIZE)
+    static const uint16_t     WIRE_BUFFER_LENGTH = WIRE_BUFFER_SIZE;
+    #else
+    static const uint16_t     WIRE_BUFFER_LENGTH = 32;
+    #endif
+    static const uint8_t      EEPROM_READ_CHUNK  = WIRE_BUFFER_LENGTH > 64 ? 64 : WIRE_BUFFER_LENGTH;
+
+    // Writes are split into chunks that the Wire buffer can hold (along with the 2 address
+    // bytes), on a boundary of the page so a chunk never wraps around in the page.  That is
+    // the largest power of two which fits the buffer, capped at the page size, so AVR writes
+    // 16 bytes at a time while cores with a bigger buffer write a whole page at once.
+    static const uint16_t     WIRE_WRITE_CHUNK   = (WIRE_BUFFER_LENGTH - 2) >= 128 ? 128
+                                                 : (WIRE_BUFFER_LENGTH - 2) >= 64  ? 64
+                                                 : (WIRE_BUFFER_LENGTH - 2) >= 32  ? 32
+                                                 : 16;
+    static const uint8_t      EEPROM_WRITE_CHUNK = WIRE_WRITE_CHUNK > EEPROM_PAGE_SIZE ? EEPROM_PAGE_SIZE : WIRE_WRITE_CHUNK;
+
+    // Superblock, when enabled, occupies the top 8 pages of the EEPROM and the log the rest.
+    //
+    //  <Superblock> ::= <Page>x8  (the page used is Sequence % 8, a page write wears the 
+    //                              whole page, so each checkpoint wears a different one)
+    //  <Page>       ::= <Slot><Unused>
+    //  <Slot>       ::= <Sequence:2><WriteAddress:2><ReadAddress:2><Magic:1><Checksum:1>  (little endian)
+    //
+    //  The slot with a good checksum and the highest sequence is the current checkpoint,
+    //  if no slot is good (or the checkpoint doesn't make sense) we fall back to searching.
+    #ifdef USE_LOG_SUPERBLOCK
+    static const uint8_t      LOG_SUPERBLOCK_SLOTS     = 8;
+    static const uint8_t      LOG_SUPERBLOCK_SLOT_SIZE = 8;
+    static const uint8_t      LOG_SUPERBLOCK_MAGIC     = 0x4C;
+    static const uint8_t      LOG_SUPERBLOCK_INTERVAL  = 16;                    // Checkpoint automatically every this many log reads/writes
+    static const EEPROMAddress EEPROM_LOG_BYTES        = EEPROM_BYTES - (LOG_SUPERBLOCK_SLOTS * EEPROM_PAGE_SIZE);
+    #else
+    static const EEPROMAddress EEPROM_LOG_BYTES        = EEPROM_BYTES;
+    #endif
+    
+    #ifdef USE_SEQUENCED_LOG
+    static const uint8_t      LOG_PAGE_HEADER          = 2;                     // Bytes of sequence number at the start of each page
+    #endif
 
     // EEPROM structure       
     //  The EEPROM is used to store "log entries" which each consist of a 5 byte header and an additional 0 to 7 data bytes.
@@ -372,25 +1333,119 @@ class DS3231_Simple
     //  <Block>     ::= <Header><DataBytes>
     //  <Header> ::= 0Bzzzwwwyy yyyyyymm mmdddddh hhhhiiii iissssss binary representation of DateTime, (zzz = number of data bytes following timestamp, www = day-of-week)
     //  <DataBytes> ::= DB1..7   
+    //
+    //  In the sequenced format (USE_SEQUENCED_LOG) blocks are instead packed into pages, and never cross a page boundary.
+    //  When the writer starts a page it writes the page's sequence number (one more than the previous page, 1..65535, 
+    //  zero for a page never written) and clears the rest of the page in the same page write, following blocks are
+    //  appended to the page without any further clearing.
+    //
+    //  <Page>      ::= <Sequence:2><Block>...<00>...
 
     
-    uint16_t                  eepromWriteAddress   = EEPROM_BYTES;               // Byte address of the "top" of the EEPROM "stack", the next
+    EEPROMAddress             eepromWriteAddress   = EEPROM_LOG_BYTES;           // Byte address of the "top" of the EEPROM "stack", the next
                                                                                 // "block" stored will be put here, this location may be 
                                                                                 // a valid block start byte, or it may be 00000000 in which case
                                                                                 // there are zero bytes until the next block start which will be
                                                                                 // the first of the series.      
                                                                                 
-    uint16_t                  eepromReadAddress = EEPROM_BYTES;                 // Byte address of the "bottom" of the EEPROM "stack", the next
+    EEPROMAddress             eepromReadAddress = EEPROM_LOG_BYTES;             // Byte address of the "bottom" of the EEPROM "stack", the next
                                                                                 // "block" to read is found here, this location may be 
                                                                                 // a valid block start byte, or it may be 00000000 in which case
                                                                                 // there are zero bytes to read.
+    
+    uint16_t                  eepromGeneration = 0;                             // Counts writes to the EEPROM, a LogCursor whose Cache was 
+                                                                                // filled at another count must read it again
 
+    /** A small window of sequentially (burst) read EEPROM bytes.
+     *  
+     *  The log functions walk the EEPROM a byte at a time, rather than doing a whole
+     *  I2C transaction for every byte, they read through one of these which fetches 
+     *  EEPROM_READ_CHUNK bytes at a time and serves following bytes from RAM.
+     *  
+     *  It starts empty (Length = 0), discard it (or set Length = 0) after writing
+     *  to the EEPROM, it does not know about writes.
+     */
+     
+    struct EEPROMReadCache
+    {
+      EEPROMAddress Address = 0;          // EEPROM address of Data[0]
+      uint8_t  Length       = 0;          // Number of valid bytes in Data
+      uint8_t  Data[EEPROM_READ_CHUNK];
+    };
+    
+    #ifdef USE_LOG_SUPERBLOCK
+    uint16_t                  eepromCheckpointSequence  = 0;                    // Sequence number of the last checkpoint written/found
+    uint8_t                   eepromCheckpointCountdown = LOG_SUPERBLOCK_INTERVAL; // Log operations until we automatically checkpoint
+    EEPROMAddress             eepromCheckpointWriteAddress = EEPROM_LOG_BYTES;  // The writer in the last checkpoint written/found (EEPROM_LOG_BYTES = none)
+    
+    /** Set eepromWriteAddress and eepromReadAddress from the newest good superblock 
+     *  checkpoint, rolling forward over anything logged or read since it was written.
+     *  
+     *  If there is no good checkpoint, or it does not agree with the EEPROM contents, 
+     *  falls back to findEEPROMWriteAddress() and findEEPROMReadAddress().
+     */
+     
+    void     restoreLogCheckpoint();
+    #endif
+    
+    #ifdef USE_SEQUENCED_LOG
+    uint16_t                  eepromWriteSequence = 0;                          // Sequence number of the page the writer is in
+    
+    /** Number of steps forward from one page sequence number to another, allowing for wrapping.
+     *  
+     *  @return 0..65534
+     */
+     
+    static uint16_t sequenceDistance(const uint16_t From, const uint16_t To);
+    
+    /** Read the sequence number at the start of a page, 0 means never written.
+     */
+     
+    uint16_t readEEPROMPageSequence(const uint16_t Page);
+    
+    /** Determine if a page has any blocks in it which are not yet read.
+     */
+     
+    uint8_t  eepromPageHasBlocks(const uint16_t Page, EEPROMReadCache &Cache);
+    #endif
+    
+    /** Forget where the log is, so that it is searched for again next time.
+     *  
+     *  @param ReadAddress Where the reader still is, if only the writer's position is in doubt.
+     */
+     
+    void     forgetLogAddresses(const EEPROMAddress ReadAddress = EEPROM_LOG_BYTES);
+    
+    /** Write the block for a log entry, during a pagewize operation.
+     *  
+     *  @see DS3231::writeBytePagewizeStart()
+     */
+     
+    void     writeLogBlockPagewize( const DateTime &timestamp, const uint8_t *data, uint8_t size );
+    
+    /** Zero the EEPROM from one address up to (not including) another, as few page writes as possible.
+     *  
+     *  In the sequenced format, page headers are left alone.
+     */
+     
+    void     clearEEPROM(const EEPROMAddress From, const EEPROMAddress To);
+    
+    /** Skip forward over blank (zero) bytes from the given address, stopping at the
+     *  next block, at the eepromWriteAddress, or after wrapping around the log once.
+     * 
+     *  @return Address of the next block (or the eepromWriteAddress), EEPROM_LOG_BYTES if nothing was found.
+     */
+     
+    EEPROMAddress skipEEPROMBlanks(EEPROMAddress Address, EEPROMReadCache &Cache);
+    
     /** Searches the EEPROM for the next place to store a block, sets eepromWriteAddress
+     *  
+     *  In the sequenced format this is a binary search of the page sequence numbers.
      *  
      *  @return eepromWriteAddress
      */
      
-    uint16_t findEEPROMWriteAddress();    
+    EEPROMAddress findEEPROMWriteAddress();    
 
     /** Delete enough complete blocks to have enough free space for the 
      *  given required number of bytes.
@@ -398,16 +1453,17 @@ class DS3231_Simple
      *  @return True/False for success/fail
      */
      
-    uint8_t  makeEEPROMSpace(uint16_t Address, int8_t BytesRequired);
+    uint8_t  makeEEPROMSpace(EEPROMAddress Address, int16_t BytesRequired);
 
     /** Find the oldest block to read (based on timestamp date), set eepromReadAddress
      *  
-     *  Note: Has to search entire EEPROM, slow.
+     *  Note: Has to search entire EEPROM, slow.  Except in the sequenced format
+     *    where it is a binary search of the pages for the oldest with a block in it.
      *  
      *  @return eepromReadAddress
      */
      
-    uint16_t findEEPROMReadAddress();
+    EEPROMAddress findEEPROMReadAddress();
 
     /** Read log timestamp and data from a given EEPROM address.
      *  
@@ -415,9 +1471,10 @@ class DS3231_Simple
      *  @param timestamp DateTime structure to put the timestamp
      *  @param data Memory location to put the data associated with the log
      *  @param size Max size of the data to read (any more is discarded)
+     *  @param Cache Read window to read the EEPROM through, may be already filled by the caller.
      */
      
-    uint16_t readLogFrom(uint16_t Address, DateTime &timestamp, uint8_t *data, uint8_t size = 0);
+    EEPROMAddress readLogFrom(EEPROMAddress Address, DateTime &timestamp, uint8_t *data, uint8_t size, EEPROMReadCache &Cache);
 
     /** Start a "pagewize" write at the eepromWriteAddress.
      *  
@@ -468,13 +1525,73 @@ class DS3231_Simple
      *  @return The data byte read.  
      *  @note   There is limited error checking, if you provide an invalid address, or the EEPROM is not responding etc behaviour is undefined (return 0, return 1, might or might not block...).
      */
-    uint8_t  readEEPROMByte(const uint16_t Address);
+    uint8_t  readEEPROMByte(const EEPROMAddress Address);
+    
+    /** Read a byte from the EEPROM through a read window, only when the Address is
+     *  outside of the window does this touch the I2C bus (to read the next chunk).
+     * 
+     *  @param Address The address of the EEPROM to read from.
+     *  @param Cache   The read window.
+     *  @return The data byte read, 0 if the EEPROM could not be read.
+     */
+     
+    uint8_t  readEEPROMByte(const EEPROMAddress Address, EEPROMReadCache &Cache);
+    
+    /** Sequentially read a number of bytes from the EEPROM.
+     * 
+     *  One address setup is done, followed by as many requestFrom() as 
+     *  are needed to fit in the Wire buffer.
+     * 
+     *  @param Address The address of the EEPROM to start reading from.
+     *  @param Buffer  Where to put the bytes.
+     *  @param Count   How many bytes to read, must not run past the end of the EEPROM.
+     *  @return Success (boolean) 1/0
+     */
+     
+    uint8_t  readEEPROMBytes(EEPROMAddress Address, uint8_t *Buffer, uint16_t Count);
 
     
   public:
-    /** Erase the EEPROM ready for storing log entries. */
+    static const uint8_t FORMAT_FULL    = 0;   // Write zero to every byte
+    static const uint8_t FORMAT_FAST    = 1;   // Read every byte, only write zero where it is not already
+    static const uint8_t FORMAT_LOGICAL = 2;   // Mark the log empty in the superblock, writing (almost) nothing
+    
+    /** Erase the EEPROM ready for storing log entries. 
+     *  
+     *  FORMAT_FULL takes over a second on an AT24C32, and a write (wear) of every page.
+     *  
+     *  FORMAT_FAST reads the EEPROM and only writes the parts of it which are not already 
+     *  blank, for an EEPROM which is mostly blank (already formatted, or with a little 
+     *  logged) this is several times faster and saves the wear.  
+     *  
+     *  FORMAT_LOGICAL, with USE_LOG_SUPERBLOCK, just checkpoints an empty log at the current 
+     *  write position, a few page writes.  The old log entries are still in the EEPROM until 
+     *  the writer comes around to them, and could be found again if the superblock is lost or
+     *  can not be used after a reset (then the EEPROM is searched).  
+     *  Without USE_LOG_SUPERBLOCK the log is found by searching the EEPROM, so there is no 
+     *  way to just mark it empty, FORMAT_FAST is done instead.
+     *  
+     *  Example:
+     *    Clock.formatEEPROM(DS3231_Simple::FORMAT_FAST);
+     *  
+     *  @param Mode FORMAT_FULL (default), FORMAT_FAST or FORMAT_LOGICAL
+     *  @return Success (boolean) 1/0
+     */
     
-    uint8_t  formatEEPROM();
+    uint8_t  formatEEPROM(const uint8_t Mode = FORMAT_FULL);
+    
+    #ifdef USE_LOG_SUPERBLOCK
+    /** Record the current log read and write positions in the superblock.
+     *  
+     *  This is done automatically every few log reads/writes, but you may want to
+     *  call it yourself just before sleeping or powering down, so that the next
+     *  start has nothing to catch up.
+     *  
+     *  @return Success (boolean) 1/0, 0 if the log positions are not yet known (nothing has been logged or read).
+     */
+     
+    uint8_t  checkpointLog();
+    #endif
   
     /** Write a log entry to the EEPROM, having current timestamp, with an attached data of arbitrary datatype (7 bytes max).
      *  
@@ -532,6 +1649,163 @@ class DS3231_Simple
     
     uint8_t  writeLog( const DateTime &timestamp,  const uint8_t *data, uint8_t size = 1 );
     
+    /** One log entry, for writing a number of log entries at once with writeLogs()
+     */
+     
+    struct LogEntry
+    {
+      DateTime Timestamp;
+      uint8_t  Size;         // Number of bytes of Data used, 7 max
+      uint8_t  Data[7];
+      
+      /** Set the timestamp and data of the entry, any arbitrary datatype consisting not more than 7 bytes.
+       */
+       
+      template <typename datatype>
+        void set( const DateTime &timestamp, const datatype &data ) {
+          Timestamp = timestamp;
+          Size      = sizeof(datatype);
+          memcpy(Data, &data, sizeof(datatype) > sizeof(Data) ? sizeof(Data) : sizeof(datatype));
+        }
+    };
+    
+    /** Write a number of log entries to the EEPROM in one go.
+     *  
+     *  The entries are packed together and written with as few page writes of the EEPROM as 
+     *  possible, (each page write takes the EEPROM about 5mS), so if you are logging often
+     *  it is quicker to collect a few entries in RAM and write them together.
+     *  
+     *  Example:
+     *     DS3231_Simple::LogEntry Entries[4];
+     *     Entries[0].set(Clock.read(), analogRead(A0));
+     *     ...
+     *     Clock.writeLogs(Entries, 4);
+     *  
+     *  @param Entries Array of entries, oldest first.
+     *  @param Count   Number of entries.
+     *  @return Success (boolean) 1/0, 0 if any entry has more than 7 bytes of data (none are written),
+     *     or with USE_ASYNC_LOG, if there is not room in the queue for all of them (none are queued).
+     */
+     
+    uint8_t  writeLogs( const LogEntry *Entries, uint8_t Count );
+    
+    /** Find where the log is in the EEPROM, if that is not already known.
+     *  
+     *  The first log operation after a reset does this for you, but it can take a while,
+     *  without USE_SEQUENCED_LOG or USE_LOG_SUPERBLOCK it reads through the whole EEPROM 
+     *  (about half a second for an AT24C32 at 100kHz).  With USE_ASYNC_LOG that would be
+     *  done by the first serviceLog() with something to write, so call this from setup() 
+     *  instead, where waiting for it does no harm.
+     *  
+     *  Example:
+     *    void setup() {
+     *      Clock.begin();
+     *      Clock.findLogAddresses();
+     *    }
+     *  
+     *  @return Success (boolean) 1/0, 0 if the EEPROM could not be read
+     */
+     
+    uint8_t  findLogAddresses();
+    
+    #ifdef USE_ASYNC_LOG
+    static const uint8_t LOG_IDLE  = 0;   // Nothing waiting to be written
+    static const uint8_t LOG_BUSY  = 1;   // Still writing, call serviceLog() again
+    static const uint8_t LOG_ERROR = 2;   // The EEPROM failed a write, or did not finish it in time
+    
+    /** Carry on writing queued log entries to the EEPROM, without waiting for it.
+     *  
+     *  With USE_ASYNC_LOG, writeLog() and writeLogs() only queue the entries, call this 
+     *  often (every loop()) and it will do one step of writing them out each time, one 
+     *  page write, or a check if the EEPROM has finished the last one, or reading enough
+     *  of the EEPROM to work out where the queued entries go.  It does not wait for the
+     *  EEPROM.  
+     *  
+     *  Where the log is in the EEPROM must be known first, or the first call with something
+     *  to write will find it, which can take a while, see findLogAddresses().
+     *  
+     *  If the EEPROM fails a write or takes more than DS3231_EEPROM_WRITE_TIMEOUT mS to 
+     *  finish one, everything queued is dropped, LOG_ERROR is returned (once), and the 
+     *  log positions will be found again from the EEPROM on the next log operation, call
+     *  findLogAddresses() when you get LOG_ERROR if that should not be serviceLog().
+     *  
+     *  Example:
+     *    void setup() {
+     *      Clock.begin();
+     *      Clock.findLogAddresses();
+     *    }
+     *    
+     *    void loop() {
+     *      if(timeToSample) Clock.writeLog(analogRead(A0)); // Returns 0 if the queue is full
+     *      if(Clock.serviceLog() == DS3231_Simple::LOG_ERROR) Clock.findLogAddresses();
+     *    }
+     *  
+     *  @return LOG_IDLE, LOG_BUSY or LOG_ERROR
+     */
+     
+    uint8_t  serviceLog();
+    
+    /** Write out everything queued, waiting for the EEPROM as needed.
+     *  
+     *  Reading the log, formatting and so on do this for you first.
+     *  
+     *  @return Success (boolean) 1/0, 0 if serviceLog() returned LOG_ERROR.
+     */
+     
+    uint8_t  flushLog();
+    
+  protected:
+    static const uint8_t      LOG_WRITE_SLOTS = 8;                              // Page writes (of EEPROM_WRITE_CHUNK) which can be pending
+    
+    /** A page write (or part of one) waiting to be sent to the EEPROM by serviceLog().
+     */
+     
+    struct EEPROMWriteSlot
+    {
+      EEPROMAddress Address;              // EEPROM address of Data[0]
+      uint8_t  Length;                    // Number of bytes to write
+      uint8_t  Data[EEPROM_WRITE_CHUNK];
+    };
+    
+    LogEntry                  logQueue[DS3231_LOG_QUEUE_LENGTH];                // Entries waiting to be written
+    uint8_t                   logQueueHead  = 0;                                // Index of the oldest in logQueue
+    uint8_t                   logQueueCount = 0;
+    
+    EEPROMWriteSlot           eepromWriteSlots[LOG_WRITE_SLOTS];                // Page writes waiting to be sent, oldest first
+    uint8_t                   eepromWriteSlotHead  = 0;
+    uint8_t                   eepromWriteSlotCount = 0;
+    
+    uint8_t                   eepromWriteDeferred = 0;                          // When set, pagewize writes go to the slots instead of the EEPROM
+    uint8_t                   eepromWriteBusy     = 0;                          // A page write was sent, and the EEPROM has not yet finished it
+    uint8_t                   eepromWriteError    = 0;                          // A page write failed or timed out
+    unsigned long             eepromWriteStarted  = 0;                          // millis() when the page write was sent
+    
+    /** Start a pending page write at the eepromWriteAddress (carrying on with the last 
+     *  one if it is in the same chunk and the address follows on from or overlaps it).
+     *  
+     *  If all the slots are in use the oldest is written now, waiting for it to finish.
+     */
+     
+    void     openEEPROMWriteSlot();
+    
+    /** Send the oldest pending page write to the EEPROM, it is then busy for a few mS.
+     *  
+     *  @return Success (boolean) 1/0
+     */
+     
+    uint8_t  sendEEPROMWriteSlot();
+    
+    /** Wait (at most DS3231_EEPROM_WRITE_TIMEOUT) for the EEPROM to finish a page write
+     *  sent by sendEEPROMWriteSlot().
+     *  
+     *  @return Success (boolean) 1/0, 0 if it timed out.
+     */
+     
+    uint8_t  waitEEPROMWrite();
+    
+  public:
+    #endif
+    
 
     /** Read the oldest log entry and clear it from EEPROM.
      *  
@@ -562,6 +1836,86 @@ class DS3231_Simple
     
     uint8_t  readLog( DateTime &timestamp,         uint8_t *data,       uint8_t size = 1 );
     
+    /** A position in the log for reading log entries without clearing them.
+     *  
+     *  Copy a cursor to remember a position (for example, to go back and send 
+     *  some entries again if sending them failed).
+     *  
+     *  Logging more entries while you have a cursor is fine, but if the log
+     *  fills and the writer wraps around over the cursor position, the cursor
+     *  is no longer meaningful, start again with beginLog().  Entries cleared in
+     *  the meantime, by readLog() or acknowledgeLog(), are skipped.
+     */
+     
+    struct LogCursor
+    {
+      EEPROMAddress   Address;       // Next block to read
+      uint16_t        Generation;    // eepromGeneration when the Cache was filled
+      EEPROMReadCache Cache;
+    };
+    
+    /** Set a cursor at the oldest log entry.
+     *  
+     *  Example:
+     *    DS3231_Simple::LogCursor Cursor;
+     *    Clock.beginLog(Cursor);
+     *    while(Clock.nextLog(Cursor, MyTimestamp, MyData)) { ... }
+     *    Clock.acknowledgeLog(Cursor); // Clear everything we just read
+     *  
+     *  @return 1 if the log was found, 0 if there is nothing in it
+     */
+     
+    uint8_t  beginLog( LogCursor &Cursor );
+    
+    /** Read the log entry at the cursor and move the cursor on to the next, the entry is NOT cleared.
+     *  
+     *  @see DS3231_Simple::readLog()
+     *  @return 1 if an entry was read, 0 if the cursor is at the end of the log
+     */
+     
+    template <typename datatype>
+      uint8_t  nextLog( LogCursor &Cursor, DateTime &timestamp,  datatype &data  )   {   
+         return nextLog(Cursor, timestamp, (uint8_t *) &data, (uint8_t)sizeof(datatype));         
+      }
+      
+    /** Read the log entry at the cursor and move the cursor on to the next, the entry is NOT cleared.
+     *  
+     *  @param Cursor    Cursor from beginLog()
+     *  @param timestamp Variable to put the timestamp of the log into.
+     *  @param data      Pointer to buffer to put data associated with the log.
+     *  @param size      Size of the data buffer.  Maximum 7 bytes.
+     *  @return 1 if an entry was read, 0 if the cursor is at the end of the log
+     */
+     
+    uint8_t  nextLog( LogCursor &Cursor, DateTime &timestamp, uint8_t *data, uint8_t size = 1 );
+    
+    /** Move the cursor forward to the first log entry at or after the given timestamp.
+     *  
+     *  To read only the log entries between two timestamps, seekLog() to the first 
+     *  and then nextLog() until compareTimestamps() says you have passed the second.
+     *  
+     *  @note Entries are searched in the order they were logged, if the clock was
+     *    set backwards at some point then this finds the first entry after From
+     *    in log order, not necessarily the earliest such entry.
+     *  
+     *  @return 1 if found, 0 if there is no such entry (the cursor is left at the end of the log)
+     */
+     
+    uint8_t  seekLog( LogCursor &Cursor, const DateTime &From );
+    
+    /** Clear all log entries before the cursor, freeing that space.
+     *  
+     *  This is done in as few page writes of the EEPROM as possible, much faster
+     *  (and less wear) than readLog() which clears each entry as it is read.
+     *  
+     *  If readLog() has been used since, and has gone past the cursor, nothing is 
+     *  cleared and 0 is returned, start again with beginLog().
+     *  
+     *  @return Success (boolean) 1/0
+     */
+     
+    uint8_t  acknowledgeLog( const LogCursor &Cursor );
+    
 
     /** Compare two DateTime objects to determine which one is older.
      *  
@@ -574,6 +1928,106 @@ class DS3231_Simple
     
     int8_t   compareTimestamps(const DateTime &A, const DateTime &B);
     
+    /** Convert a DateTime to the number of seconds since 2000-01-01 00:00:00.
+     *  
+     *  Good until 2136 (when the seconds no longer fit in 32 bits).  Like the clock,
+     *  every 4th year is a leap year.  Dow is not used.
+     *  
+     *  Can be used in a constexpr, for example
+     *    constexpr DS3231_Simple::Epoch NewYear = DS3231_Simple::toEpoch({0,0,0,0,1,1,30});
+     */
+     
+    static constexpr Epoch toEpoch(const DateTime &Timestamp)
+    {
+      // Days before this year, before this month (the 367/12 approximates the 
+      // month lengths as if February had 30 days, then February is corrected),
+      // and before today.
+      return ( ( ( (Epoch) Timestamp.Year * 365 + (Timestamp.Year + 3) / 4 
+                   + (367 * Timestamp.Month - 362) / 12 
+                   - (Timestamp.Month > 2 ? ((Timestamp.Year & 3) ? 2 : 1) : 0)
+                   + Timestamp.Day - 1 ) * 24 
+                 + Timestamp.Hour ) * 60 
+               + Timestamp.Minute ) * 60 
+             + Timestamp.Second;
+    }
+    
+    /** Convert a number of seconds since 2000-01-01 00:00:00 to a DateTime,
+     *  including the Dow (1 = Mon, 7 = Sun).
+     */
+     
+    static DateTime fromEpoch(Epoch Seconds);
+    
+    /** Move a DateTime forwards (or backwards if negative) by a number of seconds.
+     */
+     
+    static void     addSeconds(DateTime &Timestamp, int32_t Seconds);
+    
+    /** The number of seconds from B to A (negative if A is before B).
+     */
+     
+    static constexpr int32_t diffSeconds(const DateTime &A, const DateTime &B)
+    {
+      return (int32_t) (toEpoch(A) - toEpoch(B));
+    }
+    
+    #ifdef USE_STATISTICS
+    static const uint8_t STATS_READ            = 0;   // read(), snapshot()
+    static const uint8_t STATS_WRITE           = 1;   // write()
+    static const uint8_t STATS_ALARMS          = 2;   // setAlarm(), checkAlarms(), disableAlarms()
+    static const uint8_t STATS_TEMPERATURE     = 3;   // getTemperature...(), startTemperatureConversion(), temperatureReady()
+    static const uint8_t STATS_WRITE_LOG       = 4;   // writeLog(), writeLogs(), serviceLog(), flushLog()
+    static const uint8_t STATS_READ_LOG        = 5;   // readLog(), beginLog(), nextLog()
+    static const uint8_t STATS_FORMAT          = 6;   // formatEEPROM()
+    static const uint8_t STATS_OTHER           = 7;   // begin() and everything else
+    static const uint8_t STATS_APIS            = 8;
+    
+    static const uint8_t STATS_NONE            = 0xFF;
+    
+    // The call times are counted in buckets of under 250uS, 1mS, 4mS, 16mS, 64mS, and longer
+    static const uint8_t STATS_LATENCY_BUCKETS = 6;
+    
+    struct ApiStatistics
+    {
+      uint32_t Calls;
+      uint32_t Transactions;                         // I2C writes and reads
+      uint32_t Bytes;                                // Bytes written and read, not counting the I2C address
+      uint32_t Nacks;                                // Transactions not acknowledged, or short reads (includes Polls)
+      uint32_t Polls;                                // Polls of the EEPROM while it finished a page write
+      uint32_t Retries;                              // Transactions tried again, see DS3231_I2C_RETRIES
+      uint16_t Latency[STATS_LATENCY_BUCKETS];       // Count of calls taking each time, stops at 65535
+    };
+    
+    struct Statistics
+    {
+      ApiStatistics Api[STATS_APIS];                 // Indexed by STATS_READ etc
+      uint8_t       Current;                         // The call being counted, STATS_NONE between calls
+    };
+    
+    /** The counts so far (since resetStatistics()).
+     *  
+     *  Example:
+     *    uint32_t PerEntry = Clock.getStatistics().Api[DS3231_Simple::STATS_WRITE_LOG].Transactions / Entries;
+     */
+     
+    const Statistics &getStatistics() { return statistics; }
+    
+    /** Start counting again from zero.
+     */
+     
+    void     resetStatistics();
+    
+    /** Print a table of the counts, a line for each STATS_... and a column for
+     *  each count, tab separated.
+     */
+     
+    void     printStats(Stream &Printer);
+    
+  protected:
+    Statistics                statistics = { {}, STATS_NONE };
+    
+  public:
+    #endif
+    
 };
 
 typedef DS3231_Simple::DateTime DateTime;
@@ -0,0 +1,56 @@
+#include <DS3231_Simple.h>
+
+// You must uncomment USE_ASYNC_REQUESTS in DS3231_Simple.h for this example.
+#ifndef USE_ASYNC_REQUESTS
+  #error "Uncomment USE_ASYNC_REQUESTS in DS3231_Simple.h to queue requests."
+#endif
+
+DS3231_Simple Clock;
+
+unsigned long lastRequest = 0;
+unsigned long loops       = 0;
+
+void gotTime(const DS3231_Simple::Request &Done)
+{
+  if(!Done.Success) return;
+
+  Clock.printTo(Serial, Done.Time);
+  Serial.print(" ");
+}
+
+void gotTemperature(const DS3231_Simple::Request &Done)
+{
+  if(!Done.Success) return;
+
+  Serial.print(Done.Result * 0.25);
+  Serial.print("C, loop() ran ");
+  Serial.print(loops);
+  Serial.println(" times since the last.");
+  loops = 0;
+}
+
+void setup() {
+
+
+  Serial.begin(9600);
+  Serial.println();
+
+  Clock.begin();
+}
+
+void loop()
+{
+  // Every 5 seconds ask for the time and a fresh temperature measurement,
+  // they are printed when they arrive
+  if(millis() - lastRequest >= 5000)
+  {
+    lastRequest = millis();
+    Clock.requestRead(gotTime);
+    Clock.requestTemperature(gotTemperature);
+  }
+
+  // Meanwhile loop() carries on, the temperature measurement takes the clock
+  // about 200mS but we never wait for it.
+  Clock.serviceRequests();
+  loops++;
+}
@@ -78,6 +78,15 @@ void loop()
   Clock.print12HourTimeTo_HM(Serial,MyTimestamp);
   Serial.println();
   
+  // Or make up your own format, see formatTo() in DS3231_Simple.h for the codes
+  Clock.printTo(Serial, MyTimestamp, F("%d.%m.%y %l:%M %p"));
+  Serial.println();
+  
+  // Or put it into your own buffer (here as a line of CSV)
+  char Buffer[24];
+  DS3231_Simple::formatTo(Buffer, sizeof(Buffer), MyTimestamp, F("%Y-%m-%d,%H:%M:%S"));
+  Serial.println(Buffer);
+  
   Serial.println();
   
   Serial.println();
@@ -0,0 +1,55 @@
+#include <DS3231_Simple.h>
+
+// You must uncomment USE_SCHEDULER in DS3231_Simple.h for this example.
+#ifndef USE_SCHEDULER
+  #error "Uncomment USE_SCHEDULER in DS3231_Simple.h to use the scheduler."
+#endif
+
+DS3231_Simple Clock;
+
+// Connect the SQW pin of the module to this pin, the scheduler sets Alarm 1
+// for the next job, which pulls SQW low when it is due.
+const uint8_t SQW_PIN = 2;
+
+void everyTenSeconds()
+{
+  Clock.printTo(Serial); Serial.println(": Every 10 seconds");
+}
+
+void everyMinute()
+{
+  Clock.printTo(Serial); Serial.println(": Every minute");
+}
+
+void justOnce()
+{
+  Clock.printTo(Serial); Serial.println(": Just once, 25 seconds after starting");
+}
+
+void setup() {
+  
+  
+  Serial.begin(9600);  
+  Serial.println();
+  
+  Clock.begin();
+  
+  // SQW is open-drain, it needs a pullup
+  pinMode(SQW_PIN, INPUT_PULLUP);
+  
+  Clock.scheduleEvery(10, everyTenSeconds);
+  Clock.scheduleEvery(60, everyMinute);
+  Clock.scheduleAt(DS3231_Simple::toEpoch(Clock.read()) + 25, justOnce);
+  
+  Serial.println("Waiting for jobs...");
+}
+
+void loop() 
+{ 
+  // Nothing is due until the alarm pulls SQW low, you could sleep here 
+  // instead, and have the pin wake you up.
+  if(digitalRead(SQW_PIN) == LOW)
+  {
+    Clock.runJobs();
+  }
+}
@@ -0,0 +1,40 @@
+#include <DS3231_Simple.h>
+
+DS3231_Simple Clock;
+
+// Connect the SQW pin of the module to this pin, it must be one that 
+// can do interrupts (on an Uno/Nano that is 2 or 3)
+const uint8_t SQW_PIN = 2;
+
+void setup() {
+  
+  
+  Serial.begin(9600);  
+  Serial.println();
+  
+  Clock.begin();
+  
+  // Instead of asking the clock (over I2C) if a second has gone by, like 
+  // ALARM_EVERY_SECOND with checkAlarms() would, we have the clock output 
+  // a 1Hz square wave and count the ticks with an interrupt.
+  //
+  // Other rates are SQW_1024HZ, SQW_4096HZ and SQW_8192HZ
+  if(!Clock.enableTick(SQW_PIN, DS3231_Simple::SQW_1HZ))
+  {
+    Serial.println("Could not start the square wave, is the clock connected?");
+  }
+  
+  Serial.println("Waiting for ticks...");
+}
+
+void loop() 
+{ 
+  // ticked() just looks at the count the interrupt keeps, so this is 
+  // quick and does not use I2C at all
+  if(Clock.ticked())
+  {
+    Clock.printTo(Serial); 
+    Serial.print(": Tick number "); 
+    Serial.println(Clock.getTicks());
+  }
+}
@@ -14,20 +14,34 @@ void setup() {
 
 void loop() 
 { 
-  // Temperature can be read as a rounded integer value, or a floating point
-  //   float is more precise but takes a bunch of memory and flash space  
-  byte  MyIntegerTemperature;
-  float MyFloatTemperature;
+  // Temperature can be read as a rounded integer value, as a whole number of
+  //   quarter or hundredths of a degree, or as floating point.
+  //   float takes a bunch of memory and flash space, the others are just as 
+  //   precise and don't.
+  int8_t  MyIntegerTemperature;
+  int16_t MyCentidegreesTemperature;
+  float   MyFloatTemperature;
   
   // Ask the clock for the data.
-  MyIntegerTemperature = Clock.getTemperature();
-  MyFloatTemperature   = Clock.getTemperatureFloat();
+  MyIntegerTemperature      = Clock.getTemperature();
+  MyCentidegreesTemperature = Clock.getTemperatureCentidegrees();
+  MyFloatTemperature        = Clock.getTemperatureFloat();
   
   // And use it
   Serial.println("Note that temperature is updated every 64 seconds by the DS3231.");
   
   Serial.print("Integer Temperature: "); Serial.println(MyIntegerTemperature);
+  Serial.print("Fixed Temperature:   "); 
+  if(MyCentidegreesTemperature < 0) 
+  {
+    Serial.print('-');
+    MyCentidegreesTemperature = -MyCentidegreesTemperature;
+  }
+  Serial.print(MyCentidegreesTemperature / 100); 
+  Serial.print('.'); 
+  if(MyCentidegreesTemperature % 100 < 10) Serial.print('0');
+  Serial.println(MyCentidegreesTemperature % 100);
   Serial.print("Float Temperature:   "); Serial.println(MyFloatTemperature);
   Serial.println();
   delay(65000);
-}
\ No newline at end of file
+}
@@ -0,0 +1,125 @@
+#include <DS3231_Simple.h>
+
+DS3231_Simple Clock;
+
+void setup() {
+  
+  
+  Serial.begin(9600);  
+  Serial.println();
+  
+  Clock.begin();
+    
+  // Erase the contents of the EEPROM
+  Clock.formatEEPROM();
+  
+  // First we will disable any existing alarms
+  Clock.disableAlarms();
+  
+  // And now add the alarm to happen every second
+  Clock.setAlarm(DS3231_Simple::ALARM_EVERY_SECOND); 
+  
+  Serial.println(F("Logging value of analogRead(A1)"));
+  Serial.println(F("  enter 'd' to dump the log (without clearing it)"));
+  Serial.println(F("  enter 'm' to dump only the entries from the last minute"));
+  Serial.println(F("  enter 'c' to dump the log and then clear it"));
+  
+}
+
+void loop() 
+{ 
+  if(Clock.checkAlarms())
+  {
+    // Time to log a data point
+    Clock.writeLog(analogRead(A1));
+    Serial.print('.');
+  }
+  
+  if(Serial.available())
+  {
+    char c = Serial.read();
+    while(Serial.available()) Serial.read();
+    
+    switch(c)
+    {
+      case 'd': dumpLog(false); break;
+      case 'm': dumpLastMinute(); break;
+      case 'c': dumpLog(true);  break;
+    }
+  }
+}
+
+void dumpLog(bool clearAfter)
+{
+  unsigned int loggedData;
+  DateTime     loggedTime;
+  
+  // A cursor lets us read through the log without clearing the entries 
+  // as we go (like readLog() does), so we can read them as many times
+  // as we like.
+  DS3231_Simple::LogCursor Cursor;
+  Clock.beginLog(Cursor);
+  
+  unsigned int x = 0;
+  Serial.println();
+  Serial.println(F("Date,analogRead(A1)"));
+  while(Clock.nextLog(Cursor, loggedTime, loggedData))
+  {
+    x++;
+    Clock.printTo(Serial,loggedTime);
+    Serial.print(',');
+    Serial.println(loggedData);
+  }
+  Serial.print(F("# Of Log Entries Found: "));
+  Serial.println(x);
+  
+  if(clearAfter)
+  {
+    // If you were sending the log somewhere, you would only do this
+    // once you know it got there OK, otherwise just beginLog() again
+    // and try again later.
+    
+    // Clears everything up to the cursor (which is at the end now) in one go.
+    Clock.acknowledgeLog(Cursor);
+    Serial.println(F("Log Cleared"));
+  }
+  Serial.println();
+}
+
+void dumpLastMinute()
+{
+  unsigned int loggedData;
+  DateTime     loggedTime;
+  
+  // We want from one minute ago...
+  DateTime From = Clock.read();
+  if(From.Minute) 
+  {
+    From.Minute--;
+  }
+  else
+  {
+    From.Second = 0; // Keep it simple, just from the top of the hour
+  }
+  
+  // ... until now
+  DateTime Until = Clock.read();
+  
+  DS3231_Simple::LogCursor Cursor;
+  Clock.beginLog(Cursor);
+  
+  // Skip forward to the first entry at or after From
+  Clock.seekLog(Cursor, From);
+  
+  Serial.println();
+  Serial.println(F("Date,analogRead(A1)"));
+  while(Clock.nextLog(Cursor, loggedTime, loggedData))
+  {
+    if(Clock.compareTimestamps(loggedTime, Until) > 0) break; // Past the end of our range
+    
+    Clock.printTo(Serial,loggedTime);
+    Serial.print(',');
+    Serial.println(loggedData);
+  }
+  Serial.println();
+}
@@ -0,0 +1,129 @@
+// Just enough of Arduino.h to build DS3231_Simple on a PC against the simulator,
+// see Simulator.h.  Time is the simulated time, it only passes as the bus is used
+// or something waits.
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+typedef uint8_t byte;
+typedef bool    boolean;
+
+class __FlashStringHelper;
+#define F(s)              (reinterpret_cast<const __FlashStringHelper *>(s))
+#define PROGMEM
+#define PSTR(s)           (s)
+#define PGM_P             const char *
+#define pgm_read_byte(p)  (*(const uint8_t *)(p))
+#define strlen_P          strlen
+#define memcpy_P          memcpy
+
+#define INPUT         0x0
+#define OUTPUT        0x1
+#define INPUT_PULLUP  0x2
+#define LOW           0x0
+#define HIGH          0x1
+#define FALLING       2
+
+#define SDA           18
+#define SCL           19
+
+#define DEC           10
+#define HEX           16
+
+unsigned long millis();
+unsigned long micros();
+void          delay(unsigned long Millis);
+void          delayMicroseconds(unsigned int Micros);
+
+void          pinMode(uint8_t Pin, uint8_t Mode);
+void          digitalWrite(uint8_t Pin, uint8_t Value);
+int           digitalRead(uint8_t Pin);
+
+#define digitalPinToInterrupt(p)  (p)
+void          attachInterrupt(uint8_t Interrupt, void (*Handler)(void), int Mode);
+void          detachInterrupt(uint8_t Interrupt);
+
+#define noInterrupts()  do { } while(0)
+#define interrupts()    do { } while(0)
+
+class Print
+{
+  public:
+    virtual ~Print() { }
+    virtual size_t write(uint8_t) = 0;
+    virtual size_t write(const uint8_t *Buffer, size_t Size)
+    {
+      size_t n = 0;
+      while(Size--) n += write(*Buffer++);
+      return n;
+    }
+
+    size_t write(const char *Str)                  { return write((const uint8_t *)Str, strlen(Str)); }
+    size_t write(const char *Buffer, size_t Size)  { return write((const uint8_t *)Buffer, Size); }
+
+    size_t print(const char *Str)                  { return write(Str); }
+    size_t print(const __FlashStringHelper *Str)   { return write((const char *)Str); }
+    size_t print(char c)                           { return write((uint8_t)c); }
+    size_t print(unsigned long n, int Base = DEC)
+    {
+      char b[24];
+      snprintf(b, sizeof(b), Base == HEX ? "%lX" : "%lu", n);
+      return write(b);
+    }
+    size_t print(long n, int Base = DEC)
+    {
+      char b[24];
+      if(Base == HEX) return print((unsigned long)n, Base);
+      snprintf(b, sizeof(b), "%ld", n);
+      return write(b);
+    }
+    size_t print(int n, int Base = DEC)            { return print((long)n, Base); }
+    size_t print(unsigned int n, int Base = DEC)   { return print((unsigned long)n, Base); }
+    size_t print(unsigned char n, int Base = DEC)  { return print((unsigned long)n, Base); }
+    size_t print(double n, int Digits = 2)
+    {
+      char b[32];
+      snprintf(b, sizeof(b), "%.*f", Digits, n);
+      return write(b);
+    }
+
+    size_t println()                               { return write("\r\n"); }
+    template<typename T> size_t println(T Value)                 { size_t n = print(Value);        return n + println(); }
+    template<typename T> size_t println(T Value, int Format)     { size_t n = print(Value, Format); return n + println(); }
+};
+
+class Stream : public Print
+{
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() { return -1; }
+
+    size_t readBytes(char *Buffer, size_t Length)
+    {
+      size_t n = 0;
+      while(n < Length && available()) Buffer[n++] = read();
+      return n;
+    }
+};
+
+// Serial prints to stdout, and never has anything to read
+class HostSerial : public Stream
+{
+  public:
+    void   begin(unsigned long) { }
+    size_t write(uint8_t c)     { return fputc(c, stdout) == EOF ? 0 : 1; }
+    using  Print::write;
+    int    available()          { return 0; }
+    int    read()               { return -1; }
+};
+
+extern HostSerial Serial;
+
+#endif
@@ -0,0 +1,95 @@
+// writeLogs(): a batch takes far fewer EEPROM page writes than writing its entries
+// one by one, and every entry of every size reads back in order, including batches
+// that go around the end of the log.  An entry that is too big fails the whole batch.
+
+#include "DS3231_Simple.h"
+#include "HostTest.h"
+
+typedef DS3231_Simple S;
+
+static const uint8_t BATCH = 16;
+
+static S        Clock;
+static DateTime Timestamp;
+
+// The next batch of entries, Data counting on from First, sizes cycling 1 to 7 if Mixed
+static void makeBatch(S::LogEntry *Entries, const uint8_t Count, uint16_t First, const uint8_t Mixed)
+{
+  for(uint8_t x = 0; x < Count; x++)
+  {
+    S::addSeconds(Timestamp, 1);
+    Entries[x].set(Timestamp, (uint16_t)(First + x));
+    if(Mixed)
+    {
+      Entries[x].Size = 1 + (First + x) % 7;
+      for(uint8_t y = 2; y < Entries[x].Size; y++) Entries[x].Data[y] = (uint8_t)(First + x + y);
+    }
+  }
+}
+
+// The entries readLog() gives are Entries, in order
+static void expectBatch(const S::LogEntry *Entries, const uint8_t Count)
+{
+  DateTime Logged;
+  uint8_t  Data[7];
+  for(uint8_t x = 0; x < Count; x++)
+  {
+    memset(Data, 0, sizeof(Data));
+    if(   !Clock.readLog(Logged, Data, 7)
+       || S::toEpoch(Logged) != S::toEpoch(Entries[x].Timestamp)
+       || memcmp(Data, Entries[x].Data, Entries[x].Size))
+    {
+      failures++;
+      printf("FAILED entry %u of the batch\n", x);
+      return;
+    }
+  }
+}
+
+int main()
+{
+  S::LogEntry Entries[BATCH];
+  DateTime    Logged;
+  uint8_t     Data[7];
+
+  CHECK(Clock.begin());
+  CHECK(Clock.read(Timestamp));
+
+  // 16 two-byte entries one by one, then as a batch
+  CHECK(Clock.formatEEPROM(S::FORMAT_FULL));
+  makeBatch(Entries, BATCH, 0, 0);
+  sim.resetCounters();
+  for(uint8_t x = 0; x < BATCH; x++) CHECK(Clock.writeLog(Entries[x].Timestamp, Entries[x].Data, Entries[x].Size));
+  const unsigned long OneByOne = sim.writeCycles;
+  expectBatch(Entries, BATCH);
+
+  CHECK(Clock.formatEEPROM(S::FORMAT_FULL));
+  sim.resetCounters();
+  CHECK(Clock.writeLogs(Entries, BATCH));
+  const unsigned long Batched = sim.writeCycles;
+  printf("16 entries,%lu write cycles one by one,%lu batched\n", OneByOne, Batched);
+  CHECK(Batched * 2 <= OneByOne);
+  expectBatch(Entries, BATCH);
+  CHECK(!Clock.readLog(Logged, Data, 7));
+
+  // Mixed sizes, around the end of the log several times, read as they go
+  uint16_t Next = 0;
+  for(uint16_t Round = 0; Round < 200; Round++)
+  {
+    const uint8_t Count = 1 + Round % BATCH;
+    makeBatch(Entries, Count, Next, 1);
+    Next += Count;
+    CHECK(Clock.writeLogs(Entries, Count));
+    expectBatch(Entries, Count);
+  }
+  CHECK(!Clock.readLog(Logged, Data, 7));
+
+  // Too big, nothing of the batch is written
+  makeBatch(Entries, 3, 0, 0);
+  Entries[1].Size = 8;
+  CHECK(!Clock.writeLogs(Entries, 3));
+  CHECK(!Clock.readLog(Logged, Data, 7));
+
+  CHECK(!sim.overflows);
+  return failures;
+}
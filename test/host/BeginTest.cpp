@@ -0,0 +1,85 @@
+// What begin() leaves the clock doing, and what the library then thinks the square
+// wave is doing.  With USE_CACHED_CLOCK a tick() is taken as the start of a second
+// only while the square wave really is running at 1Hz.
+
+#include "DS3231_Simple.h"
+#include "HostTest.h"
+
+static const uint8_t SQW_PIN = 2;
+
+static uint32_t readSeconds(DS3231_Simple &Clock)
+{
+  DateTime Now;
+  Clock.read(Now);
+  return DS3231_Simple::toEpoch(Now);
+}
+
+int main()
+{
+  DateTime Start;
+  Start.Year = 20; Start.Month = 10; Start.Day = 3; Start.Dow = 6;
+  Start.Hour = 14; Start.Minute = 17; Start.Second = 30;
+
+  // Cold: oscillator on, INTCN set (no square wave), alarm interrupts on but the
+  // alarms set for a date that never comes, no flags
+  {
+    DS3231_Simple Clock;
+    CHECK(Clock.begin());
+    CHECK(sim.rtc[0xE] == 0x07);
+    CHECK(!(sim.rtc[0xF] & 0x03));
+    Clock.write(Start);
+
+    // No square wave, so a tick() (an alarm interrupt handed to it, say) is not a second
+    sim.advance(400000);
+    CHECK(readSeconds(Clock) == sim.clockSeconds());
+    Clock.tick();
+    Clock.tick();
+    CHECK(readSeconds(Clock) == sim.clockSeconds());
+
+    // With it the cached clock goes on with the edges
+    CHECK(Clock.enableTick(SQW_PIN, DS3231_Simple::SQW_1HZ));
+    CHECK(!(sim.rtc[0xE] & 0x04));
+    for(uint8_t x = 0; x < 5; x++) sim.advanceToNextSecond();
+    CHECK(Clock.getTicks() == 5);
+    CHECK(readSeconds(Clock) == sim.clockSeconds());
+
+    // Warm, the square wave is left running and still counted
+    DS3231_Simple Warm;
+    CHECK(Warm.begin(DS3231_Simple::BEGIN_WARM));
+    CHECK(!(sim.rtc[0xE] & 0x04));
+    Clock.disableTick();
+    CHECK(Warm.enableTick(SQW_PIN, DS3231_Simple::SQW_1HZ));
+    CHECK(readSeconds(Warm) == sim.clockSeconds());
+    sim.advanceToNextSecond();
+    CHECK(Warm.getTicks() == 1);
+
+    // Setting an alarm turns the square wave off, ticks are not seconds any more
+    Warm.setAlarm(DS3231_Simple::ALARM_EVERY_MINUTE);
+    CHECK(sim.rtc[0xE] & 0x04);
+    sim.advance(300000);
+    const uint32_t Now = readSeconds(Warm);
+    Warm.tick();
+    CHECK(readSeconds(Warm) == Now);
+
+    // As does disableSquareWave()
+    CHECK(Warm.enableSquareWave());
+    CHECK(Warm.disableSquareWave());
+    CHECK(sim.rtc[0xE] & 0x04);
+    Warm.tick();
+    CHECK(readSeconds(Warm) == sim.clockSeconds());
+    Warm.disableTick();
+  }
+
+  // Warm, with the alarms set up, they are left that way
+  {
+    DS3231_Simple Clock;
+    CHECK(Clock.begin(DS3231_Simple::BEGIN_WARM));
+    CHECK(sim.rtc[0xE] & 0x04);
+    sim.advance(300000);
+    const uint32_t Now = readSeconds(Clock);
+    Clock.tick();
+    CHECK(readSeconds(Clock) == Now);
+  }
+
+  return failures;
+}
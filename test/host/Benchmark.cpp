@@ -0,0 +1,130 @@
+// What the common operations of the library cost on the I2C bus: transactions,
+// bytes and (simulated, 100kHz) time each, for comparing before and after a change
+// or with different options in DS3231_Simple.h (the Makefile builds it with each).
+//
+//   make benchmark
+
+#include "DS3231_Simple.h"
+#include "HostTest.h"
+
+#ifdef USE_ASYNC_LOG
+  #define FLUSH(Clock) (Clock).flushLog()
+#else
+  #define FLUSH(Clock)
+#endif
+
+static void nextSecond(DateTime &Timestamp)
+{
+  DS3231_Simple::addSeconds(Timestamp, 1);
+}
+
+int main()
+{
+  DS3231_Simple *Clock = new DS3231_Simple;
+  Measure        m;
+  unsigned int   x;
+  DateTime       MyTimestamp;
+  unsigned int   MyData = 0;
+  DateTime       LoggedTime;
+  unsigned int   LoggedData;
+
+  Clock->begin();
+  Clock->read(MyTimestamp);
+
+  Measure::printHeader();
+
+  // ~~~~~~~~~~~~~~ Clock ~~~~~~~~~~~~~~
+
+  m.start();
+  for(x = 0; x < 100; x++) Clock->read(MyTimestamp);
+  m.stop(); m.print("read()", 100);
+
+  m.start();
+  for(x = 0; x < 20; x++) Clock->setAlarm(DS3231_Simple::ALARM_EVERY_SECOND);
+  m.stop(); m.print("setAlarm()", 20);
+
+  m.start();
+  for(x = 0; x < 100; x++) Clock->checkAlarms();
+  m.stop(); m.print("checkAlarms()", 100);
+
+  Clock->disableAlarms();
+
+  // ~~~~~~~~~~~~~~ EEPROM ~~~~~~~~~~~~~~
+
+  m.start();
+  Clock->formatEEPROM();
+  m.stop(); m.print("formatEEPROM(FORMAT_FULL)");
+
+  m.start();
+  Clock->formatEEPROM(DS3231_Simple::FORMAT_FAST);
+  m.stop(); m.print("formatEEPROM(FORMAT_FAST) blank");
+
+  // Each entry a second after the last, finding the log after a reset goes by the timestamps.
+  m.start();
+  for(x = 0; x < 100; x++)
+  {
+    nextSecond(MyTimestamp);
+    Clock->writeLog(MyTimestamp, MyData++);
+    FLUSH(*Clock);
+  }
+  m.stop(); m.print("writeLog()", 100);
+
+  // The batch is counted per entry
+#ifdef USE_ASYNC_LOG
+  const uint8_t BatchSize = DS3231_LOG_QUEUE_LENGTH;
+#else
+  const uint8_t BatchSize = 16;
+#endif
+  DS3231_Simple::LogEntry Entries[BatchSize];
+  for(x = 0; x < BatchSize; x++)
+  {
+    nextSecond(MyTimestamp);
+    Entries[x].set(MyTimestamp, MyData++);
+  }
+
+  m.start();
+  Clock->writeLogs(Entries, BatchSize);
+  FLUSH(*Clock);
+  m.stop(); m.print("writeLogs() per entry", BatchSize);
+
+  // A clock after a reset has to find the log first, findEEPROMReadAddress()
+  // and findEEPROMWriteAddress() (or restoring the superblock checkpoint).
+  {
+    DS3231_Simple ColdClock;
+    m.start();
+    ColdClock.readLog(LoggedTime, LoggedData);
+    m.stop(); m.print("find*Address() by first readLog() after reset");
+  }
+
+  {
+    DS3231_Simple ColdClock;
+    nextSecond(MyTimestamp);
+    m.start();
+    ColdClock.writeLog(MyTimestamp, MyData);
+    FLUSH(ColdClock);
+    m.stop(); m.print("find*Address() by first writeLog() after reset");
+  }
+
+  // Our own Clock doesn't know what the cold clocks did, start it afresh too.
+  delete Clock;
+  Clock = new DS3231_Simple;
+  Clock->readLog(LoggedTime, LoggedData);
+
+  m.start();
+  for(x = 0; x < 100 && Clock->readLog(LoggedTime, LoggedData); x++);
+  m.stop(); m.print("readLog()", x);
+
+  m.start();
+  Clock->formatEEPROM(DS3231_Simple::FORMAT_FAST);
+  m.stop(); m.print("formatEEPROM(FORMAT_FAST) used");
+
+  m.start();
+  Clock->formatEEPROM(DS3231_Simple::FORMAT_LOGICAL);
+  m.stop(); m.print("formatEEPROM(FORMAT_LOGICAL)");
+
+  delete Clock;
+
+  // Anything dropped by Wire would make all of this meaningless
+  CHECK(!sim.overflows);
+  return failures;
+}
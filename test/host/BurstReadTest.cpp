@@ -0,0 +1,75 @@
+// The EEPROM is read in bursts of the Wire buffer (EEPROM_READ_CHUNK), not a
+// transaction for every byte: transactions and bytes on the bus for reading the
+// log, and for the scans to find it after a reset.
+
+#include "DS3231_Simple.h"
+#include "HostTest.h"
+
+static const unsigned int ENTRIES     = 300;
+static const unsigned int EEPROM_SIZE = DS3231_EEPROM_SIZE_KBIT * 128UL;
+
+// A transaction for every byte would be 2 (the address, then the read) and 6 bytes
+// (the address 3, the read 2 and a byte) each.  Bursts of EEPROM_READ_CHUNK are the
+// same 2 transactions, for (EEPROM_READ_CHUNK + 5) bytes.
+static const unsigned int CHUNK       = BUFFER_LENGTH > 64 ? 64 : BUFFER_LENGTH;
+static const unsigned int SCAN_READS  = EEPROM_SIZE / CHUNK;
+
+int main()
+{
+  DS3231_Simple *Clock = new DS3231_Simple;
+  Measure        m;
+  DateTime       Timestamp;
+  DateTime       Logged;
+  uint16_t       Data;
+
+  Clock->begin();
+  Clock->read(Timestamp);
+  Clock->formatEEPROM();
+
+  // Finding the (empty) log reads through it all, a burst at a time
+  {
+    DS3231_Simple Cold;
+    m.start();
+    CHECK(!Cold.readLog(Logged, Data));
+    m.stop(); m.print("empty log, first readLog() after reset");
+    CHECK(m.eepromReads <= 2 * SCAN_READS + 4);
+    CHECK(m.bytes <= 2 * (EEPROM_SIZE + SCAN_READS * 6) + 32);
+  }
+
+  for(uint16_t x = 0; x < ENTRIES; x++)
+  {
+    DS3231_Simple::addSeconds(Timestamp, 1);
+    Clock->writeLog(Timestamp, x);
+#ifdef USE_ASYNC_LOG
+    Clock->flushLog();
+#endif
+  }
+
+  // And when it is full of entries
+  {
+    DS3231_Simple Cold;
+    m.start();
+    CHECK(Cold.readLog(Logged, Data) && Data == 0);
+    m.stop(); m.print("log of 300, first readLog() after reset");
+    CHECK(m.eepromReads <= 2 * SCAN_READS + 8);
+    CHECK(m.bytes <= 2 * (EEPROM_SIZE + SCAN_READS * 6) + 256);
+  }
+
+  // Each entry (7 bytes) is one burst, unless it straddles two, then clearing it
+  // reads what it clears in another (a read for every byte would be 14 or more)
+  m.start();
+  unsigned int Read;
+  for(Read = 1; Read < ENTRIES; Read++)
+  {
+    if(!Clock->readLog(Logged, Data) || Data != Read) break;
+  }
+  m.stop(); m.print("readLog()", ENTRIES - 1);
+  CHECK(Read == ENTRIES);
+  CHECK(m.eepromReads <= 4 * (ENTRIES - 1));
+  CHECK(!Clock->readLog(Logged, Data));
+
+  delete Clock;
+
+  CHECK(!sim.overflows);
+  return failures;
+}
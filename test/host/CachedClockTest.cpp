@@ -0,0 +1,82 @@
+// USE_CACHED_CLOCK: read() every mS for two minutes gives the clock's time, while only
+// reading the clock every DS3231_CLOCK_RESYNC_INTERVAL, with and without tick(), and
+// write() and a resync bring the cache up to date.
+
+#include "DS3231_Simple.h"
+#include "HostTest.h"
+
+#ifndef USE_CACHED_CLOCK
+  #error "Build with -DUSE_CACHED_CLOCK"
+#endif
+
+typedef DS3231_Simple S;
+
+static const uint8_t SQW_PIN = 2;
+
+// read() every mS for Seconds, the number of times it was not the clock's time (as
+// near as millis() can say, the clock's time a mS either side will do)
+static unsigned long readEveryMilli(S &Clock, const unsigned long Seconds)
+{
+  unsigned long Wrong  = 0;
+  uint32_t      Before = sim.clockSeconds();
+  for(unsigned long x = 0; x < Seconds * 1000; x++)
+  {
+    const uint32_t Now  = sim.clockSeconds();
+    const uint32_t Read = S::toEpoch(Clock.read());
+    sim.advance(1000);
+    if(Read != Now && Read != Before && Read != sim.clockSeconds()) Wrong++;
+    Before = Now;
+  }
+  return Wrong;
+}
+
+int main()
+{
+  S        Clock;
+  DateTime Start;
+  Start.Year = 25; Start.Month = 7; Start.Day = 4; Start.Dow = 5;
+  Start.Hour = 9; Start.Minute = 59; Start.Second = 0;
+
+  CHECK(Clock.begin());
+
+  // Written, then read from the cache straight away
+  CHECK(Clock.write(Start));
+  sim.resetCounters();
+  CHECK(S::toEpoch(Clock.read()) == S::toEpoch(Start));
+  CHECK(!sim.transactions);
+
+  // Counted on with millis()
+  sim.resetCounters();
+  unsigned long Wrong = readEveryMilli(Clock, 120);
+  printf("cached read() every mS for 120s,%lu transactions,%lu wrong\n", sim.transactions, Wrong);
+  CHECK(!Wrong);
+  CHECK(sim.transactions <= 2 * (120000UL / DS3231_CLOCK_RESYNC_INTERVAL + 1));
+
+  // Counted on with the 1Hz edges
+  CHECK(Clock.enableTick(SQW_PIN, S::SQW_1HZ));
+  sim.resetCounters();
+  Wrong = readEveryMilli(Clock, 120);
+  printf("cached read() with tick() every mS for 120s,%lu transactions,%lu wrong\n", sim.transactions, Wrong);
+  CHECK(!Wrong);
+  CHECK(sim.transactions <= 2 * (120000UL / DS3231_CLOCK_RESYNC_INTERVAL + 1));
+  Clock.disableTick();
+
+  // Written while the status read after it had to be retried, the second still starts
+  // when the time was written
+  sim.advance(400000);
+  sim.failAfter = 1;
+  sim.failNext  = 1;
+  CHECK(Clock.write(Start));
+  CHECK(!sim.failNext);
+  Wrong = readEveryMilli(Clock, 5);
+  printf("cached read() every mS for 5s after a retry in write(),%lu wrong\n", Wrong);
+  CHECK(!Wrong);
+
+  // Set by someone else, picked up within the resync interval
+  sim.setClockSeconds(sim.clockSeconds() + 3600);
+  sim.advance(DS3231_CLOCK_RESYNC_INTERVAL * 1000UL);
+  CHECK(S::toEpoch(Clock.read()) == sim.clockSeconds());
+
+  CHECK(!sim.overflows);
+  return failures;
+}
@@ -0,0 +1,70 @@
+// startTemperatureConversion() and temperatureReady(): nothing waits on the clock, the
+// result is the fresh measurement, and one already under way (BSY) is waited for
+// instead of starting another.
+
+#include "DS3231_Simple.h"
+#include "HostTest.h"
+
+static const unsigned long POLL_MICROS = 5000;
+
+int main()
+{
+  DS3231_Simple Clock;
+
+  CHECK(Clock.begin());
+
+  // Nothing started, ready without asking the clock
+  sim.resetCounters();
+  CHECK(Clock.temperatureReady());
+  CHECK(!sim.transactions);
+
+  // Started, polled until done
+  sim.temperature = 91;
+  unsigned long Began = sim.now;
+  CHECK(Clock.startTemperatureConversion());
+  CHECK(sim.rtc[0xE] & 0x20);
+  CHECK(sim.now - Began < 1000);
+
+  unsigned long Polls = 0, Longest = 0;
+  while(1)
+  {
+    unsigned long Before = sim.now;
+    uint8_t       Ready  = Clock.temperatureReady();
+    if(sim.now - Before > Longest) Longest = sim.now - Before;
+    Polls++;
+    if(Ready || sim.now - Began > 1000000UL) break;
+    sim.advance(POLL_MICROS);
+  }
+  printf("conversion,%lu polls,%lu uS,longest call %lu uS\n", Polls, sim.now - Began, Longest);
+  CHECK(sim.now - Began >= Simulator::CONVERSION_MICROS);
+  CHECK(sim.now - Began <  Simulator::CONVERSION_MICROS + 2 * POLL_MICROS);
+  CHECK(Longest < 1000);
+  CHECK(sim.conversions == 1);
+  CHECK(Clock.getTemperatureQuarters() == 91);
+
+  // Done, ready again without the bus
+  sim.resetCounters();
+  CHECK(Clock.temperatureReady());
+  CHECK(!sim.transactions);
+
+  // The clock busy with its own conversion, CONV is left alone and that one waited for
+  sim.rtc[0xF] |= 0x04;
+  CHECK(Clock.startTemperatureConversion());
+  CHECK(!(sim.rtc[0xE] & 0x20));
+  sim.advance(POLL_MICROS);
+  CHECK(!Clock.temperatureReady());
+  sim.rtc[0xF] &= ~0x04;
+  sim.rtc[0x11] = 0x18;
+  sim.rtc[0x12] = 0x40;
+  CHECK(Clock.temperatureReady());
+  CHECK(Clock.getTemperatureQuarters() == 97);
+  CHECK(sim.conversions == 1);
+
+  // A clock which doesn't answer can't start one
+  sim.failNext = DS3231_I2C_RETRIES + 1;
+  CHECK(!Clock.startTemperatureConversion());
+  CHECK(Clock.getLastError());
+
+  CHECK(!sim.overflows);
+  return failures;
+}
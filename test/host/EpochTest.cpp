@@ -0,0 +1,88 @@
+// compareTimestamps() (field by field) against comparing toEpoch(), for the same
+// answers and for speed, and the Epoch conversions and arithmetic.  No bus here.
+
+#include "DS3231_Simple.h"
+#include "HostTest.h"
+#include <chrono>
+
+static const unsigned long COMPARISONS = 4000000;
+static const unsigned int  DATES       = 1024;
+
+static int8_t compareEpochs(const DateTime &A, const DateTime &B)
+{
+  const DS3231_Simple::Epoch a = DS3231_Simple::toEpoch(A);
+  const DS3231_Simple::Epoch b = DS3231_Simple::toEpoch(B);
+  return (a > b) - (a < b);
+}
+
+static DateTime randomDate(const uint8_t SameDay)
+{
+  return DS3231_Simple::fromEpoch(SameDay ? 700000000UL + rand() % 86400 : (uint32_t) rand() % (136UL * 365 * 86400));
+}
+
+// Nanoseconds for each comparison of all the pairs of Dates
+template <typename Compare>
+static double timeIt(Compare Function, const DateTime *Dates, long &Sum)
+{
+  std::chrono::steady_clock::time_point Started = std::chrono::steady_clock::now();
+  for(unsigned long x = 0; x < COMPARISONS; x++)
+  {
+    Sum += Function(Dates[x % DATES], Dates[(x * 7 + 1) % DATES]);
+  }
+  std::chrono::duration<double, std::nano> Elapsed = std::chrono::steady_clock::now() - Started;
+  return Elapsed.count() / COMPARISONS;
+}
+
+int main()
+{
+  DS3231_Simple Clock;
+  DateTime      Dates[DATES];
+  long          Sum = 0;
+
+  srand(1);
+
+  // Round trips, and Dow (2000-01-01 was a Saturday, 6)
+  CHECK(DS3231_Simple::fromEpoch(0).Dow == 6);
+  for(uint32_t s = 0; s < 136UL * 365 * 86400; s += 86400UL * 13 + 3607)
+  {
+    if(DS3231_Simple::toEpoch(DS3231_Simple::fromEpoch(s)) != s) { CHECK(0); break; }
+  }
+
+  DateTime t = DS3231_Simple::fromEpoch(59UL * 86400 - 1);       // 2000-02-28 23:59:59
+  DS3231_Simple::addSeconds(t, 1);
+  CHECK(t.Month == 2 && t.Day == 29 && t.Hour == 0 && t.Second == 0);
+  DS3231_Simple::addSeconds(t, 86400L * 400);
+  CHECK(DS3231_Simple::toEpoch(t) == 459UL * 86400);
+  DS3231_Simple::addSeconds(t, -86400L * 400);
+  CHECK(DS3231_Simple::toEpoch(t) == 59UL * 86400);
+  CHECK(DS3231_Simple::diffSeconds(DS3231_Simple::fromEpoch(100), DS3231_Simple::fromEpoch(40)) == 60);
+
+  // The same answers, including for equal dates
+  for(uint8_t SameDay = 0; SameDay < 2; SameDay++)
+  {
+    for(unsigned int x = 0; x < DATES; x++) Dates[x] = randomDate(SameDay);
+    Dates[1] = Dates[0];
+    for(unsigned int a = 0; a < DATES; a += 3)
+    {
+      for(unsigned int b = 0; b < DATES; b += 5)
+      {
+        if(Clock.compareTimestamps(Dates[a], Dates[b]) != compareEpochs(Dates[a], Dates[b])) { CHECK(0); a = DATES; break; }
+      }
+    }
+    CHECK(Clock.compareTimestamps(Dates[0], Dates[1]) == 0);
+
+    // The log's "newer than anything" sentinel, Year 255, is past the end of the Epoch
+    DateTime Never = Dates[0];
+    Never.Year = 255;
+    CHECK(Clock.compareTimestamps(Never, Dates[0]) > 0);
+
+    printf("%s,compareTimestamps() %.1f nS,toEpoch() compare %.1f nS\n",
+           SameDay ? "same day" : "random dates",
+           timeIt([&](const DateTime &A, const DateTime &B) { return Clock.compareTimestamps(A, B); }, Dates, Sum),
+           timeIt(compareEpochs, Dates, Sum));
+  }
+
+  // So that the timed loops are not optimised away
+  if(Sum == 0x7FFFFFFF) printf(" ");
+  return failures;
+}
@@ -0,0 +1,410 @@
+// A bus that fails: transient faults are retried, lasting ones are reported by
+// getLastError() and don't lose or corrupt anything, checkAlarms() never reports
+// an alarm it did not read or clear, and never leaves the clock stopped.
+
+#include "DS3231_Simple.h"
+#include "HostTest.h"
+#include <vector>
+
+#ifdef USE_ASYNC_LOG
+  #define WRITE_LOG(Timestamp, Data) (Clock->writeLog(Timestamp, Data) && Clock->flushLog())
+#else
+  #define WRITE_LOG(Timestamp, Data) Clock->writeLog(Timestamp, Data)
+#endif
+
+// All the attempts at one transaction
+static const unsigned ATTEMPTS = DS3231_I2C_RETRIES + 1;
+
+static const uint8_t  EOSC     = 0x80;
+
+static DS3231_Simple *Clock;
+
+static void testClock()
+{
+  DateTime Now;
+
+  // Transient, retried
+  sim.failNext = 1;
+  CHECK(Clock->read(Now) && Now.Day);
+  CHECK(!Clock->getLastError());
+
+  // Lasting, reported (once)
+  sim.failNext = 100;
+  CHECK(!Clock->read(Now) && !Now.Day);
+  CHECK(Clock->getLastError() == DS3231_Simple::ERROR_ADDRESS_NACK);
+  CHECK(!Clock->getLastError());
+  sim.failNext = 0;
+}
+
+static void testRecoverBus()
+{
+  DateTime      Now;
+  unsigned long Begins = Wire.begins;
+
+  // Wire has to let go of the pins before they are clocked, and get them back after
+  sim.resetCounters();
+  CHECK(Clock->recoverBus(18, 19));
+  CHECK(!sim.pinsTakenFromWire);
+  CHECK(Wire.enabled && Wire.begins == Begins + 1);
+  CHECK(Clock->read(Now) && Now.Day);
+}
+
+static void testSetup()
+{
+  DateTime Now;
+
+  // Nothing works
+  sim.failNext = 1000;
+  CHECK(!Clock->disableAlarms());
+  CHECK(Clock->getLastError());
+  CHECK(!Clock->begin());
+  CHECK(Clock->getLastError());
+  sim.failNext = 0;
+  CHECK(Clock->begin());
+  CHECK(sim.rtc[0xE] == 0x07);
+
+  // The control register can't be written (the alarms are already set to never)
+  CHECK(Clock->enableSquareWave());
+  sim.failNext = ATTEMPTS;
+  CHECK(!Clock->disableAlarms());
+  CHECK(Clock->getLastError());
+  CHECK(!(sim.rtc[0xE] & 0x04));
+  CHECK(Clock->disableAlarms());
+  CHECK(sim.rtc[0xE] == 0x07);
+
+  // The flags can't be cleared
+  sim.rtc[0xF] |= 0x03;
+  sim.failAfter = 2;                        // Reading the status works
+  sim.failNext  = ATTEMPTS;
+  CHECK(!Clock->disableAlarms());
+  CHECK(Clock->getLastError());
+  CHECK((sim.rtc[0xF] & 0x03) == 0x03);
+  sim.failAfter = 0;
+  CHECK(Clock->disableAlarms());
+  CHECK(!(sim.rtc[0xF] & 0x03));
+
+  // write() can't clear the Oscillator Stop Flag
+  CHECK(Clock->read(Now));
+  sim.rtc[0xF] |= 0x80;
+  sim.failAfter = 3;                        // The time, reading the status
+  sim.failNext  = ATTEMPTS;
+  CHECK(!Clock->write(Now));
+  CHECK(Clock->getLastError());
+  CHECK(sim.rtc[0xF] & 0x80);
+  sim.failAfter = 0;
+  CHECK(Clock->write(Now));
+  CHECK(!(sim.rtc[0xF] & 0x80));
+}
+
+static void testCheckAlarms()
+{
+  Clock->setAlarm(DS3231_Simple::ALARM_EVERY_SECOND);
+  Clock->checkAlarms();
+
+  // The status can't be read, with the clock paused: no alarm (not the control
+  // register's A1IE), nothing written to the status, and the clock restarted
+  sim.advanceToNextSecond();
+  CHECK(sim.rtc[0xF] & 0x01);
+  sim.failAfter = 1;                        // Pausing works
+  sim.failNext  = ATTEMPTS;                 // Reading the status doesn't
+  CHECK(Clock->checkAlarms(true) == 0);
+  CHECK(Clock->getLastError() == DS3231_Simple::ERROR_ADDRESS_NACK);
+  CHECK(sim.rtc[0xF] & 0x01);               // Still there to be found
+  CHECK(!(sim.rtc[0xF] & 0x04) && !(sim.rtc[0xF] & 0x70));
+  CHECK(!(sim.rtc[0xE] & EOSC));
+  CHECK(Clock->checkAlarms(true) == 1);
+  CHECK(!(sim.rtc[0xF] & 0x01));
+
+  // And without pausing it
+  sim.advanceToNextSecond();
+  sim.failNext = ATTEMPTS;
+  CHECK(Clock->checkAlarms() == 0);
+  CHECK(Clock->getLastError());
+  CHECK(sim.rtc[0xF] & 0x01);
+  CHECK(Clock->checkAlarms() == 1);
+
+  // The clock can't be restarted: the alarm is still reported (it was cleared),
+  // the error too, and the next checkAlarms() restarts it
+  sim.advanceToNextSecond();
+  sim.failAfter = 4;                        // Pause, status (2), clear
+  sim.failNext  = 100;
+  CHECK(Clock->checkAlarms(true) == 1);
+  CHECK(Clock->getLastError());
+  CHECK(sim.rtc[0xE] & EOSC);
+  sim.failNext  = 0;
+  sim.failAfter = 0;
+  CHECK(Clock->checkAlarms() == 0);
+  CHECK(!(sim.rtc[0xE] & EOSC));
+  CHECK(!Clock->getLastError());
+
+  // Pausing fails, nothing is left paused
+  sim.failNext = ATTEMPTS;
+  Clock->checkAlarms(true);
+  Clock->getLastError();
+  CHECK(!(sim.rtc[0xE] & EOSC));
+
+  // Clearing the alarm fails, it isn't reported until it can be
+  sim.advanceToNextSecond();
+  sim.failAfter = 2;                        // Reading the status works
+  sim.failNext  = ATTEMPTS;
+  CHECK(Clock->checkAlarms() == 0);
+  CHECK(Clock->getLastError());
+  CHECK(sim.rtc[0xF] & 0x01);
+  sim.failAfter = 0;
+  CHECK(Clock->checkAlarms() == 1);
+
+  // The same from a snapshot
+  DS3231_Simple::Snapshot Snap;
+  sim.advanceToNextSecond();
+  CHECK(Clock->snapshot(Snap) && Snap.Alarms == 1);
+  sim.failNext = ATTEMPTS;
+  CHECK(Clock->checkAlarms(Snap) == 0);
+  CHECK(Clock->getLastError());
+  CHECK(sim.rtc[0xF] & 0x01);
+  CHECK(Clock->checkAlarms(Snap) == 1);
+  CHECK(!(sim.rtc[0xF] & 0x01));
+
+  Clock->disableAlarms();
+}
+
+static void testLog()
+{
+  std::vector<uint16_t> Written;
+  DateTime              Timestamp;
+  DateTime              Logged;
+  uint16_t              Data;
+
+  Clock->read(Timestamp);
+  Clock->formatEEPROM(DS3231_Simple::FORMAT_FAST);
+
+  // Short faults now and then while writing, what writeLog() says was written must
+  // all read back, once each, in order, through faults while reading too
+  srand(1);
+  for(uint16_t x = 0; x < 300; x++)
+  {
+    if(!(rand() % 4)) sim.failNext = 1 + rand() % 4;
+    DS3231_Simple::addSeconds(Timestamp, 1);
+    if(WRITE_LOG(Timestamp, x)) Written.push_back(x); else Clock->getLastError();
+    sim.failNext = 0;
+  }
+
+  size_t   Read    = 0;
+  unsigned Retries = 0;
+  while(Retries < 1000)
+  {
+    if(!(rand() % 4)) sim.failNext = 1 + rand() % 4;
+    const uint8_t Got = Clock->readLog(Logged, Data);
+    const uint8_t Failed = Clock->getLastError() || sim.failNext;
+    sim.failNext = 0;
+
+    if(!Got)
+    {
+      if(!Failed) break;
+      Retries++;
+      continue;
+    }
+
+    // A failed clear can give the same entry again, never a later one early
+    if(Read && Data == Written[Read - 1]) continue;
+    if(Read >= Written.size() || Data != Written[Read]) { CHECK(0); break; }
+    Read++;
+  }
+  printf("log with faults,%zu of 300 written,%zu read back\n", Written.size(), Read);
+  CHECK(Written.size() > 200);
+  CHECK(Read == Written.size());
+
+  // A lasting fault while reading loses nothing
+  for(uint16_t x = 1000; x < 1020; x++)
+  {
+    DS3231_Simple::addSeconds(Timestamp, 1);
+    WRITE_LOG(Timestamp, x);
+  }
+  CHECK(Clock->readLog(Logged, Data) && Data == 1000);
+  sim.failNext = 1000;
+  CHECK(!Clock->readLog(Logged, Data));
+  CHECK(Clock->getLastError());
+  sim.failNext = 0;
+  for(uint16_t x = 1001; x < 1020; x++)
+  {
+    if(!Clock->readLog(Logged, Data) || Data != x) { CHECK(0); break; }
+  }
+  CHECK(!Clock->readLog(Logged, Data));
+
+  // And while writing, the log still works after
+  sim.failNext = 1000;
+  CHECK(!WRITE_LOG(Timestamp, (uint16_t) 7));
+  CHECK(Clock->getLastError());
+  sim.failNext = 0;
+  CHECK(WRITE_LOG(Timestamp, (uint16_t) 8));
+  CHECK(Clock->readLog(Logged, Data) && Data == 8);
+}
+
+// No EEPROM at all: finding, reading and writing the log each give up after the
+// first read or write that fails, not a byte at a time through the whole EEPROM
+static void testNoEEPROM()
+{
+  DateTime Timestamp;
+  DateTime Logged;
+  uint16_t Data;
+  Measure  m;
+
+  Clock->read(Timestamp);
+  Clock->formatEEPROM(DS3231_Simple::FORMAT_FAST);
+  for(uint16_t x = 0; x < 20; x++)
+  {
+    DS3231_Simple::addSeconds(Timestamp, 1);
+    WRITE_LOG(Timestamp, x);
+  }
+
+  // With the log positions known, and then after a reset
+  for(uint8_t Reset = 0; Reset < 2; Reset++)
+  {
+    if(Reset)
+    {
+      delete Clock;
+      Clock = new DS3231_Simple;
+    }
+
+    sim.failNext = 100000;
+    m.start();
+    CHECK(!Clock->readLog(Logged, Data));
+    m.stop();
+    CHECK(Clock->getLastError());
+    printf("readLog() without an EEPROM,%s,%lu transactions,%lu uS\n", Reset ? "after a reset" : "positions known", m.transactions, m.micros);
+    CHECK(m.transactions <= 4 * ATTEMPTS);
+
+    m.start();
+    CHECK(!WRITE_LOG(Timestamp, (uint16_t) 99));
+    m.stop();
+    CHECK(Clock->getLastError());
+    printf("writeLog() without an EEPROM,%s,%lu transactions,%lu uS\n", Reset ? "after a reset" : "positions known", m.transactions, m.micros);
+    CHECK(m.transactions <= 4 * ATTEMPTS);
+    sim.failNext = 0;
+  }
+
+  // Still all there
+  for(uint16_t x = 0; x < 20; x++)
+  {
+    if(!Clock->readLog(Logged, Data) || Data != x) { CHECK(0); break; }
+  }
+  CHECK(!Clock->readLog(Logged, Data));
+}
+
+static void testFormat()
+{
+  DateTime Timestamp;
+  DateTime Logged;
+  uint16_t Data;
+
+  Clock->read(Timestamp);
+  Clock->formatEEPROM(DS3231_Simple::FORMAT_FAST);
+  for(uint16_t x = 0; x < 50; x++)
+  {
+    DS3231_Simple::addSeconds(Timestamp, 1);
+    WRITE_LOG(Timestamp, x);
+  }
+
+  // No EEPROM, neither format says it worked, or takes long to find out
+  Measure m;
+  m.start();
+  sim.failNext = 100000;
+  CHECK(!Clock->formatEEPROM(DS3231_Simple::FORMAT_FULL));
+  CHECK(Clock->getLastError());
+  CHECK(!Clock->formatEEPROM(DS3231_Simple::FORMAT_FAST));
+  CHECK(Clock->getLastError());
+  sim.failNext = 0;
+  m.stop();
+  CHECK(m.transactions < 5 * ATTEMPTS);
+
+  // Nothing was wiped, the log is found again
+  for(uint16_t x = 0; x < 50; x++)
+  {
+    if(!Clock->readLog(Logged, Data) || Data != x) { CHECK(0); break; }
+  }
+
+  // Failing part way through
+  DS3231_Simple::addSeconds(Timestamp, 1);
+  WRITE_LOG(Timestamp, (uint16_t) 50);
+  sim.failAfter = 10;
+  sim.failNext  = 100000;
+  CHECK(!Clock->formatEEPROM(DS3231_Simple::FORMAT_FULL));
+  CHECK(Clock->getLastError());
+  sim.failNext  = 0;
+  sim.failAfter = 0;
+
+  CHECK(Clock->formatEEPROM(DS3231_Simple::FORMAT_FAST));
+  CHECK(!Clock->readLog(Logged, Data));
+}
+
+#ifdef USE_LOG_SUPERBLOCK
+static void testFormatLogical()
+{
+  DateTime Timestamp;
+  DateTime Logged;
+  uint16_t Data;
+
+  Clock->read(Timestamp);
+  Clock->formatEEPROM(DS3231_Simple::FORMAT_FAST);
+  for(uint16_t x = 0; x < 10; x++)
+  {
+    DS3231_Simple::addSeconds(Timestamp, 1);
+    WRITE_LOG(Timestamp, x);
+  }
+
+  // Clearing after the writer fails, nothing is checkpointed and the log is still there
+  sim.failNext = 1000;
+  CHECK(!Clock->formatEEPROM(DS3231_Simple::FORMAT_LOGICAL));
+  CHECK(Clock->getLastError());
+  sim.failNext = 0;
+
+  // So does finding the writer, after a reset
+  delete Clock;
+  Clock = new DS3231_Simple;
+  sim.failNext = 1000;
+  CHECK(!Clock->formatEEPROM(DS3231_Simple::FORMAT_LOGICAL));
+  CHECK(Clock->getLastError());
+  sim.failNext = 0;
+
+  delete Clock;
+  Clock = new DS3231_Simple;
+  for(uint16_t x = 0; x < 10; x++)
+  {
+    if(!Clock->readLog(Logged, Data) || Data != x) { CHECK(0); break; }
+  }
+  CHECK(!Clock->readLog(Logged, Data));
+
+  // And when nothing fails it is empty
+  DS3231_Simple::addSeconds(Timestamp, 1);
+  WRITE_LOG(Timestamp, (uint16_t) 10);
+  CHECK(Clock->formatEEPROM(DS3231_Simple::FORMAT_LOGICAL));
+  CHECK(!Clock->readLog(Logged, Data));
+}
+#endif
+
+int main()
+{
+  Clock = new DS3231_Simple;
+  Clock->begin();
+
+  testClock();
+  testRecoverBus();
+  testSetup();
+  testCheckAlarms();
+  testLog();
+  testNoEEPROM();
+  testFormat();
+#ifdef USE_LOG_SUPERBLOCK
+  testFormatLogical();
+#endif
+
+  // Nothing extra when nothing fails
+  DateTime Now;
+  Measure  m;
+  m.start();
+  Clock->read(Now);
+  m.stop();
+  CHECK(m.transactions == 2);
+
+  delete Clock;
+  return failures;
+}
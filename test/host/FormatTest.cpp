@@ -0,0 +1,91 @@
+// What formatTo() and the print functions give for a few timestamps (the year 2100,
+// midnight and noon among them), each print being a single write to the Stream, and
+// formatTo() cutting the result short to fit the buffer.
+
+#include "DS3231_Simple.h"
+#include "HostTest.h"
+
+typedef DS3231_Simple S;
+
+// Keeps what is printed to it, and how many writes it took
+class Capture : public Stream
+{
+  public:
+    char     text[64];
+    uint8_t  length = 0;
+    unsigned writes = 0;
+
+    size_t write(uint8_t c)                        { return write(&c, 1); }
+    size_t write(const uint8_t *Buffer, size_t Size)
+    {
+      writes++;
+      while(Size-- && length < sizeof(text) - 1) text[length++] = *Buffer++;
+      text[length] = 0;
+      return length;
+    }
+    using  Print::write;
+    int    available()                             { return 0; }
+    int    read()                                  { return -1; }
+
+    void   clear()                                 { length = 0; writes = 0; text[0] = 0; }
+};
+
+static Capture Printed;
+
+#define CHECK_PRINTED(Call, Expected) \
+  do { Printed.clear(); Call; CHECK(!strcmp(Printed.text, Expected) && Printed.writes == 1); \
+       if(strcmp(Printed.text, Expected)) printf("  printed \"%s\"\n", Printed.text); } while(0)
+
+static DateTime at(uint8_t Year, uint8_t Month, uint8_t Day, uint8_t Hour, uint8_t Minute, uint8_t Second)
+{
+  DateTime Timestamp;
+  Timestamp.Year = Year; Timestamp.Month = Month; Timestamp.Day = Day; Timestamp.Dow = 1;
+  Timestamp.Hour = Hour; Timestamp.Minute = Minute; Timestamp.Second = Second;
+  return Timestamp;
+}
+
+int main()
+{
+  S        Clock;
+  char     Buffer[32];
+  DateTime Afternoon = at(24, 2, 29, 13, 5, 9);
+  DateTime Midnight  = at(0, 1, 1, 0, 0, 0);
+  DateTime Noon      = at(100, 12, 31, 12, 30, 59);
+
+  CHECK_PRINTED(Clock.printTo(Printed, Afternoon),               "2024-02-29T13:05:09");
+  CHECK_PRINTED(Clock.printTo(Printed, Noon),                    "2100-12-31T12:30:59");
+  CHECK_PRINTED(Clock.printDateTo_DMY(Printed, Afternoon),       "29/02/2024");
+  CHECK_PRINTED(Clock.printDateTo_MDY(Printed, Afternoon, '.'),  "02.29.2024");
+  CHECK_PRINTED(Clock.printDateTo_YMD(Printed, Midnight),        "2000-01-01");
+  CHECK_PRINTED(Clock.printTimeTo_HMS(Printed, Afternoon),       "13:05:09");
+  CHECK_PRINTED(Clock.printTimeTo_HM(Printed, Afternoon, 'h'),   "13h05");
+  CHECK_PRINTED(Clock.print12HourTimeTo_HMS(Printed, Afternoon), "1:05:09 PM");
+  CHECK_PRINTED(Clock.print12HourTimeTo_HMS(Printed, Midnight),  "12:00:00 AM");
+  CHECK_PRINTED(Clock.print12HourTimeTo_HM(Printed, Noon),       "12:30 PM");
+
+  // Every code, an unknown one gives just its letter
+  CHECK(S::formatTo(Buffer, sizeof(Buffer), Afternoon, F("%Y %y %m %d %u")) == 15);
+  CHECK(!strcmp(Buffer, "2024 24 02 29 1"));
+  CHECK(S::formatTo(Buffer, sizeof(Buffer), Afternoon, F("%H %I %l %M %S %p %% %q")) == 20);
+  CHECK(!strcmp(Buffer, "13 01 1 05 09 PM % q"));
+  S::formatTo(Buffer, sizeof(Buffer), Midnight, F("%I:%M %p"));
+  CHECK(!strcmp(Buffer, "12:00 AM"));
+  S::formatTo(Buffer, sizeof(Buffer), Noon, F("%l%p, %Y"));
+  CHECK(!strcmp(Buffer, "12PM, 2100"));
+
+  // Cut short, and always terminated
+  memset(Buffer, 'x', sizeof(Buffer));
+  CHECK(S::formatTo(Buffer, 8, Afternoon, F("%Y-%m-%d")) == 7);
+  CHECK(!strcmp(Buffer, "2024-02") && Buffer[8] == 'x');
+  CHECK(S::formatTo(Buffer, 1, Afternoon, F("%Y")) == 0 && !Buffer[0]);
+  CHECK(S::formatTo(Buffer, 0, Afternoon, F("%Y")) == 0);
+
+  CHECK_PRINTED(Clock.printTo(Printed, Afternoon, F("%d/%m/%Y %l:%M %p")), "29/02/2024 1:05 PM");
+
+  // The time from the clock
+  CHECK(Clock.begin());
+  Clock.write(Afternoon);
+  CHECK_PRINTED(Clock.printTo(Printed, F("%H:%M")), "13:05");
+
+  return failures;
+}
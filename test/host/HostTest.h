@@ -0,0 +1,63 @@
+// Helpers for the host tests and benchmarks, see Simulator.h
+
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+#include "Simulator.h"
+
+// Count (and print) a failed check, main() returns failures so make sees it
+static int failures = 0;
+
+#define CHECK(Condition) \
+  do { if(!(Condition)) { failures++; printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #Condition); } } while(0)
+
+// The bus traffic and simulated time of what is done between start() and stop()
+class Measure
+{
+  public:
+    unsigned long transactions;
+    unsigned long bytes;
+    unsigned long micros;
+    unsigned long eepromReads;
+    unsigned long writeCycles;
+
+    void start()
+    {
+      sim.resetCounters();
+      startedAt = sim.now;
+    }
+
+    void stop()
+    {
+      transactions = sim.transactions;
+      bytes        = sim.bytes;
+      micros       = sim.now - startedAt;
+      eepromReads  = sim.eepromReads;
+      writeCycles  = sim.writeCycles;
+    }
+
+    /** Print a line of the CSV results, the figures are for each of Count operations.
+     */
+
+    void print(const char *Operation, const unsigned long Count = 1)
+    {
+      if(!Count)
+      {
+        printf("%s,0,,,\n", Operation);
+        return;
+      }
+      printf("%s,%lu,%.1f,%.1f,%lu\n", Operation, Count,
+             (double) transactions / Count, (double) bytes / Count, micros / Count);
+    }
+
+    static void printHeader()
+    {
+      printf("Operation,Count,Transactions each,Bytes each,uS each\n");
+    }
+
+  protected:
+    unsigned long startedAt;
+};
+
+#endif
@@ -0,0 +1,114 @@
+// Reading the log with a cursor, and acknowledgeLog() clearing only what is
+// before the cursor (and nothing at all for a cursor readLog() has gone past),
+// and a cursor not giving entries that have been cleared since it read them in.
+
+#include "DS3231_Simple.h"
+#include "HostTest.h"
+
+#ifdef USE_ASYNC_LOG
+  #define WRITE_LOG(Timestamp, Data) (Clock.writeLog(Timestamp, Data) && Clock.flushLog())
+#else
+  #define WRITE_LOG(Timestamp, Data) Clock.writeLog(Timestamp, Data)
+#endif
+
+static DS3231_Simple Clock;
+static DateTime      Timestamp;
+
+static void logEntries(const uint16_t From, const uint16_t To)
+{
+  for(uint16_t x = From; x < To; x++)
+  {
+    DS3231_Simple::addSeconds(Timestamp, 1);
+    CHECK(WRITE_LOG(Timestamp, x));
+  }
+}
+
+// The entries readLog() gives, From up to To, and then nothing
+static void expectEntries(const uint16_t From, const uint16_t To)
+{
+  DateTime Logged;
+  uint16_t Data;
+  for(uint16_t x = From; x < To; x++)
+  {
+    if(!Clock.readLog(Logged, Data) || Data != x)
+    {
+      failures++;
+      printf("FAILED expected entry %u\n", x);
+      return;
+    }
+  }
+  CHECK(!Clock.readLog(Logged, Data));
+}
+
+int main()
+{
+  DS3231_Simple::LogCursor Cursor;
+  DateTime                 Logged;
+  uint16_t                 Data;
+
+  Clock.begin();
+  Clock.read(Timestamp);
+
+  // Acknowledging what the cursor has read
+  Clock.formatEEPROM(DS3231_Simple::FORMAT_FAST);
+  logEntries(0, 10);
+  CHECK(Clock.beginLog(Cursor));
+  for(uint16_t x = 0; x < 4; x++) CHECK(Clock.nextLog(Cursor, Logged, Data) && Data == x);
+  CHECK(Clock.acknowledgeLog(Cursor));
+  expectEntries(4, 10);
+
+  // A cursor that readLog() has gone past clears nothing
+  Clock.formatEEPROM(DS3231_Simple::FORMAT_FAST);
+  logEntries(0, 5);
+  CHECK(Clock.beginLog(Cursor));
+  CHECK(Clock.nextLog(Cursor, Logged, Data) && Data == 0);
+  CHECK(Clock.readLog(Logged, Data) && Data == 0);
+  CHECK(Clock.readLog(Logged, Data) && Data == 1);
+  CHECK(!Clock.acknowledgeLog(Cursor));
+  expectEntries(2, 5);
+
+  // Entries cleared since the cursor read near them are not given from what it had read
+  // ahead, whether readLog() or another cursor's acknowledgeLog() cleared them
+  Clock.formatEEPROM(DS3231_Simple::FORMAT_FAST);
+  logEntries(0, 10);
+  CHECK(Clock.beginLog(Cursor));
+  CHECK(Clock.nextLog(Cursor, Logged, Data) && Data == 0);
+  for(uint16_t x = 0; x < 3; x++) CHECK(Clock.readLog(Logged, Data) && Data == x);
+  CHECK(Clock.nextLog(Cursor, Logged, Data) && Data == 3);
+  {
+    DS3231_Simple::LogCursor Other;
+    CHECK(Clock.beginLog(Other));
+    for(uint16_t x = 3; x < 6; x++) CHECK(Clock.nextLog(Other, Logged, Data) && Data == x);
+    CHECK(Clock.acknowledgeLog(Other));
+  }
+  CHECK(Clock.nextLog(Cursor, Logged, Data) && Data == 6);
+  expectEntries(6, 10);
+
+  // Up to the cursor at the end, everything
+  Clock.formatEEPROM(DS3231_Simple::FORMAT_FAST);
+  logEntries(0, 5);
+  CHECK(Clock.beginLog(Cursor));
+  while(Clock.nextLog(Cursor, Logged, Data));
+  CHECK(Clock.acknowledgeLog(Cursor));
+  expectEntries(0, 0);
+
+  // Going around the end of the EEPROM, and after a reset
+  Clock.formatEEPROM(DS3231_Simple::FORMAT_FAST);
+  logEntries(0, 500);
+  expectEntries(0, 500);
+  logEntries(500, 700);
+  {
+    DS3231_Simple Cold;
+    CHECK(Cold.beginLog(Cursor));
+    for(uint16_t x = 500; x < 650; x++)
+    {
+      if(!Cold.nextLog(Cursor, Logged, Data) || Data != x) { CHECK(0); break; }
+    }
+    CHECK(Cold.acknowledgeLog(Cursor));
+  }
+  Clock = DS3231_Simple();
+  expectEntries(650, 700);
+
+  CHECK(!sim.overflows);
+  return failures;
+}
@@ -0,0 +1,63 @@
+// How many reads ("probes") of the EEPROM it takes to find the log after a reset,
+// for a half full, full and wrapped log.  The Makefile builds it twice, the default
+// log found by scanning all the timestamps, and USE_SEQUENCED_LOG found by binary
+// searching the page sequence numbers, so compare the two.
+
+#include "DS3231_Simple.h"
+#include "HostTest.h"
+
+// 7 byte entries, 4 to a 32 byte page in either format
+static const unsigned int HALF    = 200;
+static const unsigned int FULL    = 450;
+static const unsigned int WRAPPED = 1000;
+
+static void measure(const char *Name, const unsigned int Entries)
+{
+  DS3231_Simple *Clock = new DS3231_Simple;
+  DateTime       Timestamp;
+  Measure        m;
+
+  sim.powerOn();
+  Clock->begin();
+  Clock->read(Timestamp);
+  Clock->formatEEPROM(DS3231_Simple::FORMAT_FAST);
+  for(uint16_t x = 0; x < Entries; x++)
+  {
+    DS3231_Simple::addSeconds(Timestamp, 1);
+    Clock->writeLog(Timestamp, x);
+  }
+  delete Clock;
+
+  // After a reset the log is found when it is first used
+  Clock = new DS3231_Simple;
+  DS3231_Simple::LogCursor Cursor;
+  m.start();
+  CHECK(Clock->beginLog(Cursor));
+  m.stop();
+
+  printf("%s (%u entries),%lu,%lu,%lu,%lu\n", Name, Entries, m.eepromReads, m.transactions, m.bytes, m.micros);
+
+#ifdef USE_SEQUENCED_LOG
+  // Two binary searches of 128 pages
+  CHECK(m.eepromReads <= 2 * 8 + 4);
+#endif
+
+  // And found right, the oldest entry is still there until the log wraps
+  DateTime Logged;
+  uint16_t Data = 0xFFFF;
+  CHECK(Clock->nextLog(Cursor, Logged, Data));
+  if(Entries < FULL + 1) CHECK(Data == 0); else CHECK(Data > 0 && Data < Entries);
+  delete Clock;
+}
+
+int main()
+{
+  printf("Log,EEPROM reads,Transactions,Bytes,uS\n");
+
+  measure("half full", HALF);
+  measure("full",      FULL);
+  measure("wrapped",   WRAPPED);
+
+  CHECK(!sim.overflows);
+  return failures;
+}
@@ -0,0 +1,114 @@
+// USE_ASYNC_REQUESTS: queued requests are done one per serviceRequests(), oldest first,
+// each handed to its callback (which may queue another), a full queue refuses more, and
+// a temperature measurement is polled without waiting for it, or given up on.
+
+#include "DS3231_Simple.h"
+#include "HostTest.h"
+
+#ifndef USE_ASYNC_REQUESTS
+  #error "Build with -DUSE_ASYNC_REQUESTS"
+#endif
+
+typedef DS3231_Simple S;
+
+static S          Clock;
+static S::Request Done[8];
+static uint8_t    Dones = 0;
+
+static void record(const S::Request &Request)
+{
+  if(Dones < 8) Done[Dones] = Request;
+  Dones++;
+}
+
+// Queues a read from its callback, as a sketch reading the time after setting it would
+static void readAfter(const S::Request &Request)
+{
+  record(Request);
+  CHECK(Clock.requestRead(record));
+}
+
+int main()
+{
+  DateTime Start;
+  Start.Year = 21; Start.Month = 6; Start.Day = 1; Start.Dow = 3;
+  Start.Hour = 12; Start.Minute = 0; Start.Second = 0;
+
+  CHECK(Clock.begin());
+  CHECK(Clock.serviceRequests() == S::REQUESTS_IDLE);
+
+  // Four in order, a fifth refused, nothing done until serviced
+  sim.resetCounters();
+  CHECK(Clock.requestWrite(Start, record));
+  CHECK(Clock.requestAlarm(Start, S::ALARM_EVERY_SECOND, record));
+  CHECK(Clock.requestRead(record));
+  CHECK(Clock.requestCheckAlarms(record));
+  CHECK(!Clock.requestRead(record));
+  CHECK(!sim.transactions);
+
+  sim.advanceToNextSecond();
+  CHECK(Clock.serviceRequests() == S::REQUESTS_BUSY && Dones == 1);
+  CHECK(Clock.serviceRequests() == S::REQUESTS_BUSY && Dones == 2);
+  CHECK(Clock.serviceRequests() == S::REQUESTS_BUSY && Dones == 3);
+  sim.advanceToNextSecond();
+  CHECK(Clock.serviceRequests() == S::REQUESTS_IDLE && Dones == 4);
+
+  CHECK(Done[0].Operation == S::REQUEST_WRITE && Done[0].Success);
+  CHECK(Done[1].Operation == S::REQUEST_SET_ALARM && Done[1].Success);
+  CHECK(Done[2].Operation == S::REQUEST_READ && Done[2].Success);
+  CHECK(S::toEpoch(Done[2].Time) == S::toEpoch(Start) && Done[2].Time.Year == 21);
+  CHECK(Done[3].Operation == S::REQUEST_CHECK_ALARMS && Done[3].Success && Done[3].Result);
+  CHECK(sim.clockSeconds() >= S::toEpoch(Start));
+
+  // A callback queueing another, done on the next call
+  Dones = 0;
+  CHECK(Clock.requestWrite(Start, readAfter));
+  CHECK(Clock.serviceRequests() == S::REQUESTS_BUSY && Dones == 1);
+  CHECK(Clock.serviceRequests() == S::REQUESTS_IDLE && Dones == 2);
+  CHECK(Done[1].Operation == S::REQUEST_READ && Done[1].Success);
+  CHECK(S::toEpoch(Done[1].Time) == S::toEpoch(Start));
+
+  // A temperature below zero, no call waits on the conversion
+  Dones           = 0;
+  sim.temperature = -37;
+  CHECK(Clock.requestTemperature(record));
+  unsigned long Longest = 0, Calls = 0, Began = sim.now;
+  while(!Dones && sim.now - Began < 2000000UL)
+  {
+    unsigned long Before = sim.now;
+    Clock.serviceRequests();
+    if(sim.now - Before > Longest) Longest = sim.now - Before;
+    Calls++;
+    sim.advance(500);
+  }
+  printf("temperature request,%lu calls,%lu uS,longest call %lu uS\n", Calls, sim.now - Began, Longest);
+  CHECK(Dones == 1 && Done[0].Operation == S::REQUEST_TEMPERATURE && Done[0].Success);
+  CHECK(Done[0].Result == -37);
+  CHECK(Longest < 1000);
+  CHECK(sim.conversions == 1);
+
+  // One which never finishes (the clock stops answering) fails after the timeout, 1s
+  Dones = 0;
+  CHECK(Clock.requestTemperature(record));
+  CHECK(Clock.serviceRequests() == S::REQUESTS_BUSY);
+  sim.failNext = 0xFFFF;
+  Began = sim.now;
+  while(!Dones && sim.now - Began < 5000000UL)
+  {
+    Clock.serviceRequests();
+    sim.advance(10000);
+  }
+  sim.failNext = 0;
+  Clock.getLastError();
+  CHECK(Dones == 1 && !Done[0].Success);
+  CHECK(sim.now - Began >= 1000000UL);
+
+  // And the next one starts afresh
+  Dones = 0;
+  CHECK(Clock.requestTemperature(record));
+  while(!Dones) { Clock.serviceRequests(); sim.advance(1000); }
+  CHECK(Done[0].Success && Done[0].Result == -37);
+
+  CHECK(!sim.overflows);
+  return failures;
+}
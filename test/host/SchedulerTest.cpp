@@ -0,0 +1,137 @@
+// The scheduler against the simulated clock: a day of jobs every 7 seconds, every
+// minute and every hour, one off jobs (one 40 days ahead), a job that cancels itself
+// and schedules another, waking only when Alarm 1 pulls the interrupt pin low.
+
+#include "DS3231_Simple.h"
+#include "HostTest.h"
+
+struct Expected
+{
+  const char          *Name;
+  DS3231_Simple::Epoch Next;                // When it should run next, 0 for never
+  uint32_t             Interval;
+  unsigned int         Runs;
+};
+
+static DS3231_Simple Clock;
+static Expected      expected[6];
+static uint8_t       selfCancelling;
+static uint8_t       woken = 0;
+
+static void onAlarm() { woken = 1; }
+
+static void ran(const uint8_t Job)
+{
+  const DS3231_Simple::Epoch Now = sim.clockSeconds();
+  if(Now != expected[Job].Next)
+  {
+    failures++;
+    printf("FAILED %s ran at %lu, expected %lu\n", expected[Job].Name, (unsigned long) Now, (unsigned long) expected[Job].Next);
+  }
+  expected[Job].Runs++;
+  expected[Job].Next = expected[Job].Interval ? Now + expected[Job].Interval : 0;
+}
+
+static void every7()   { ran(0); }
+static void every60()  { ran(1); }
+static void hourly()   { ran(2); }
+static void once()     { ran(3); }
+static void later()    { ran(5); }
+
+static void cancelsItself()
+{
+  ran(4);
+  if(expected[4].Runs == 3)
+  {
+    CHECK(Clock.cancelJob(selfCancelling));
+    expected[4].Next = 0;
+
+    // And scheduling from inside a job
+    expected[5].Next = sim.clockSeconds() + 500;
+    CHECK(Clock.scheduleAt(expected[5].Next, later));
+  }
+}
+
+int main()
+{
+  Clock.begin();
+
+  DateTime Start;
+  Start.Year = 20; Start.Month = 2; Start.Day = 28; Start.Dow = 5;
+  Start.Hour = 23; Start.Minute = 59; Start.Second = 50;
+  Clock.write(Start);
+  const DS3231_Simple::Epoch Now = sim.clockSeconds();
+  CHECK(Now == DS3231_Simple::toEpoch(Start));
+
+  const Expected Jobs[6] = {
+    { "every 7 seconds",  Now + 7,    7,    0 },
+    { "every minute",     Now + 60,   60,   0 },
+    { "every hour",       Now + 3600, 3600, 0 },
+    { "once",             Now + 1000, 0,    0 },
+    { "cancels itself",   Now + 13,   13,   0 },
+    { "scheduled by job", 0,          0,    0 },
+  };
+  memcpy(expected, Jobs, sizeof(expected));
+
+  CHECK(Clock.scheduleEvery(7, every7));
+  CHECK(Clock.scheduleEvery(60, every60));
+  CHECK(Clock.scheduleEvery(3600, hourly));
+  CHECK(Clock.scheduleAt(Now + 1000, once));
+  CHECK(selfCancelling = Clock.scheduleEvery(13, cancelsItself));
+
+  // Sleep until the alarm, for a day
+  attachInterrupt(digitalPinToInterrupt(2), onAlarm, FALLING);
+  sim.resetCounters();
+  unsigned long Wakes = 0, Run = 0, Spurious = 0;
+  for(unsigned long x = 0; x < 86400; x++)
+  {
+    sim.advanceToNextSecond();
+    if(!woken) continue;
+    woken = 0;
+    Wakes++;
+    const uint8_t n = Clock.runJobs();
+    Run += n;
+    if(!n) Spurious++;
+  }
+
+  const unsigned long Expect = 86400 / 7 + 86400 / 60 + 86400 / 3600 + 1 + 3 + 1;
+  printf("day of jobs,wakes %lu,jobs run %lu,transactions each wake %.1f\n", Wakes, Run, (double) sim.transactions / Wakes);
+  CHECK(Run == Expect);
+  CHECK(!Spurious);
+  for(uint8_t x = 0; x < 6; x++) CHECK(expected[x].Runs == (x == 4 ? 3 : x == 3 || x == 5 ? 1 : 86400 / Jobs[x].Interval));
+
+  // Cancelling what isn't there
+  CHECK(!Clock.cancelJob(0));
+  CHECK(!Clock.cancelJob(DS3231_SCHEDULER_JOBS + 1));
+
+  // A job 40 days ahead, Alarm 1 can only match a day of the month so it may
+  // wake on the way, but the job only runs on time
+  for(uint8_t x = 0; x < 6; x++) expected[x].Next = 0;
+  for(uint8_t x = 1; x <= DS3231_SCHEDULER_JOBS; x++) Clock.cancelJob(x);
+  CHECK(!Clock.nextJobDue());
+
+  expected[3].Next = sim.clockSeconds() + 40UL * 86400 + 17;
+  expected[3].Runs = 0;
+  CHECK(Clock.scheduleAt(expected[3].Next, once));
+  Wakes = 0;
+  for(unsigned long x = 0; x < 41UL * 86400; x++)
+  {
+    sim.advanceToNextSecond();
+    if(!woken) continue;
+    woken = 0;
+    Wakes++;
+    Clock.runJobs();
+  }
+  printf("job 40 days ahead,wakes %lu\n", Wakes);
+  CHECK(expected[3].Runs == 1);
+  CHECK(Wakes <= 3);
+  CHECK(!Clock.nextJobDue());
+
+  // Only so many jobs
+  uint8_t Jobs2 = 0;
+  while(Clock.scheduleEvery(100, every7)) Jobs2++;
+  CHECK(Jobs2 == DS3231_SCHEDULER_JOBS);
+
+  detachInterrupt(digitalPinToInterrupt(2));
+  return failures;
+}
@@ -0,0 +1,87 @@
+// The copy of the alarm and control registers: a write of what they already hold
+// is skipped, the clock's registers always end up as written, a failed write or
+// resyncRegisters() has them read again, and CONV is always written.
+
+#include "DS3231_Simple.h"
+#include "HostTest.h"
+
+typedef DS3231_Simple S;
+
+// The transactions of what was done since the last call
+static unsigned long transactions()
+{
+  unsigned long Transactions = sim.transactions;
+  sim.resetCounters();
+  return Transactions;
+}
+
+int main()
+{
+  S        Clock;
+  DateTime Alarm;
+  Alarm.Year = 23; Alarm.Month = 3; Alarm.Day = 14; Alarm.Dow = 2;
+  Alarm.Hour = 15; Alarm.Minute = 9; Alarm.Second = 26;
+
+  CHECK(Clock.begin());
+  CHECK(sim.rtc[0xE] == 0x07);
+
+  // Already disabled, nothing to write (only the flags are looked at)
+  transactions();
+  CHECK(Clock.disableAlarms());
+  CHECK(transactions() <= 2);
+
+  // Set once, the same again is free
+  CHECK(Clock.setAlarm(Alarm, S::ALARM_MATCH_SECOND_MINUTE_HOUR_DATE));
+  CHECK(transactions() == 1);
+  const uint8_t Minute = sim.rtc[0x8];
+  CHECK(Clock.setAlarm(Alarm, S::ALARM_MATCH_SECOND_MINUTE_HOUR_DATE));
+  CHECK(!transactions());
+  CHECK(sim.rtc[0x7] == 0x26 && sim.rtc[0x8] == Minute && sim.rtc[0x9] == 0x15 && sim.rtc[0xA] == 0x14);
+
+  // The square wave is a control register write, and only when it changes
+  CHECK(Clock.enableSquareWave(S::SQW_1024HZ));
+  CHECK(transactions() == 1);
+  CHECK((sim.rtc[0xE] & 0x1C) == 0x08);
+  CHECK(Clock.enableSquareWave(S::SQW_1024HZ));
+  CHECK(!transactions());
+  CHECK(Clock.disableSquareWave());
+  CHECK((sim.rtc[0xE] & 0x07) == 0x07);
+  const uint8_t Control = sim.rtc[0xE];
+
+  // Changed behind our back, not seen until resyncRegisters()
+  sim.rtc[0x7] = 0x00;
+  CHECK(Clock.setAlarm(Alarm, S::ALARM_MATCH_SECOND_MINUTE_HOUR_DATE));
+  CHECK(sim.rtc[0x7] == 0x00);
+  CHECK(Clock.resyncRegisters());
+  CHECK(Clock.setAlarm(Alarm, S::ALARM_MATCH_SECOND_MINUTE_HOUR_DATE));
+  CHECK(sim.rtc[0x7] == 0x26);
+
+  // A failed write forgets the copy, so the same alarm again is written
+  Alarm.Second = 27;
+  sim.failNext = DS3231_I2C_RETRIES + 1;
+  CHECK(!Clock.setAlarm(Alarm, S::ALARM_MATCH_SECOND_MINUTE_HOUR_DATE));
+  CHECK(Clock.getLastError());
+  CHECK(sim.rtc[0x7] == 0x26);
+  CHECK(Clock.setAlarm(Alarm, S::ALARM_MATCH_SECOND_MINUTE_HOUR_DATE));
+  CHECK(sim.rtc[0x7] == 0x27);
+
+  // CONV clears itself, so each conversion is asked for
+  for(uint8_t x = 0; x < 2; x++)
+  {
+    CHECK(Clock.startTemperatureConversion());
+    CHECK(sim.rtc[0xE] & 0x20);
+    while(!Clock.temperatureReady()) sim.advance(10000);
+  }
+  CHECK(sim.conversions == 2);
+  CHECK(sim.rtc[0xE] == Control);
+
+  // A snapshot brings the copy up to date as well
+  sim.rtc[0x7] = 0x00;
+  S::Snapshot Snap;
+  CHECK(Clock.snapshot(Snap));
+  CHECK(Clock.setAlarm(Alarm, S::ALARM_MATCH_SECOND_MINUTE_HOUR_DATE));
+  CHECK(sim.rtc[0x7] == 0x27);
+
+  CHECK(!sim.overflows);
+  return failures;
+}
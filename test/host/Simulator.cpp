@@ -0,0 +1,445 @@
+// The simulated bus and devices, see Simulator.h, and the Arduino functions
+// that depend on them.
+
+#include "Simulator.h"
+#include "Wire.h"
+#include "DS3231_Simple.h"    // Only for the EEPROM size options, so the simulator matches the library
+
+Simulator  sim;
+TwoWire    Wire;
+TwoWire    Wire1;
+HostSerial Serial;
+
+// ~~~~~~~~~~~~~~ Arduino ~~~~~~~~~~~~~~
+
+unsigned long millis()                                   { return sim.now / 1000; }
+unsigned long micros()                                   { return sim.now; }
+void          delay(unsigned long Millis)                { sim.advance(Millis * 1000); }
+void          delayMicroseconds(unsigned int Micros)     { sim.advance(Micros); }
+
+// Taking the pins while the I2C hardware still has them doesn't reach the bus
+void          pinMode(uint8_t, uint8_t)                  { if(Wire.enabled || Wire1.enabled) sim.pinsTakenFromWire++; }
+void          digitalWrite(uint8_t, uint8_t)             { if(Wire.enabled || Wire1.enabled) sim.pinsTakenFromWire++; }
+int           digitalRead(uint8_t)                       { return HIGH; }   // Bus lines pulled up, and idle
+
+void          attachInterrupt(uint8_t, void (*Handler)(void), int) { sim.interruptHandler = Handler; }
+void          detachInterrupt(uint8_t)                   { sim.interruptHandler = 0; }
+
+// ~~~~~~~~~~~~~~ Wire ~~~~~~~~~~~~~~
+
+void TwoWire::begin()
+{
+  begins++;
+  enabled = 1;
+}
+
+void TwoWire::beginTransmission(uint8_t Address)
+{
+  txAddress = Address;
+  txLength  = 0;
+}
+
+size_t TwoWire::write(uint8_t Data)
+{
+  // Like the AVR Wire, what does not fit the buffer is dropped
+  if(txLength >= BUFFER_LENGTH)
+  {
+    sim.overflows++;
+    return 0;
+  }
+  txBuffer[txLength++] = Data;
+  return 1;
+}
+
+uint8_t TwoWire::endTransmission(uint8_t SendStop)
+{
+  (void) SendStop;
+  if(txAddress == Simulator::RTC_ADDRESS) rtcTransactions++; else eepromTransactions++;
+  return sim.write(txAddress, txBuffer, txLength);
+}
+
+uint8_t TwoWire::requestFrom(uint8_t Address, uint8_t Quantity, uint8_t SendStop)
+{
+  (void) SendStop;
+  if(Address == Simulator::RTC_ADDRESS) rtcTransactions++; else eepromTransactions++;
+
+  // Like the AVR Wire, which will not read more than fits the buffer
+  if(Quantity > BUFFER_LENGTH) Quantity = BUFFER_LENGTH;
+
+  rxPosition = 0;
+  rxLength   = sim.read(Address, rxBuffer, Quantity);
+  return rxLength;
+}
+
+// ~~~~~~~~~~~~~~ Calendar ~~~~~~~~~~~~~~
+
+static uint8_t fromBcd(const uint8_t Value) { return (Value >> 4) * 10 + (Value & 0xF); }
+static uint8_t toBcd(const uint8_t Value)   { return ((Value / 10) << 4) | (Value % 10); }
+
+static uint16_t daysInYear(const uint8_t Year) { return (Year % 4) ? 365 : 366; }   // 2000 to 2099 (2100 is not, but never mind)
+
+static uint8_t daysInMonth(const uint8_t Year, const uint8_t Month)
+{
+  if(Month == 2) return (Year % 4) ? 28 : 29;
+  if(Month == 4 || Month == 6 || Month == 9 || Month == 11) return 30;
+  return 31;
+}
+
+void Simulator::secondsToRegisters(uint32_t Seconds)
+{
+  rtc[0] = toBcd(Seconds % 60); Seconds /= 60;
+  rtc[1] = toBcd(Seconds % 60); Seconds /= 60;
+  rtc[2] = toBcd(Seconds % 24); Seconds /= 24;
+
+  uint8_t Year = 0;
+  while(Seconds >= daysInYear(Year)) Seconds -= daysInYear(Year++);
+
+  uint8_t Month = 1;
+  while(Seconds >= daysInMonth(Year, Month)) Seconds -= daysInMonth(Year, Month++);
+
+  rtc[4] = toBcd(Seconds + 1);
+  rtc[5] = toBcd(Month) | (Year >= 100 ? 0x80 : 0);
+  rtc[6] = toBcd(Year % 100);
+}
+
+uint32_t Simulator::registersToSeconds()
+{
+  const uint8_t Year  = fromBcd(rtc[6]) + ((rtc[5] & 0x80) ? 100 : 0);
+  const uint8_t Month = fromBcd(rtc[5] & 0x1F);
+
+  uint32_t Days = fromBcd(rtc[4] & 0x3F) - 1;
+  for(uint8_t y = 0; y < Year;  y++) Days += daysInYear(y);
+  for(uint8_t m = 1; m < Month; m++) Days += daysInMonth(Year, m);
+
+  uint8_t Hour;
+  if(rtc[2] & 0x40)
+  {
+    // 12 hour mode
+    Hour = fromBcd(rtc[2] & 0x1F) % 12 + ((rtc[2] & 0x20) ? 12 : 0);
+  }
+  else
+  {
+    Hour = fromBcd(rtc[2] & 0x3F);
+  }
+
+  return ((Days * 24 + Hour) * 60 + fromBcd(rtc[1] & 0x7F)) * 60 + fromBcd(rtc[0] & 0x7F);
+}
+
+// ~~~~~~~~~~~~~~ Simulator ~~~~~~~~~~~~~~
+
+void Simulator::powerOn()
+{
+  now = 1000000;
+  resetCounters();
+  overflows = 0;
+  failNext  = 0;
+  failAfter = 0;
+
+  // DS3231 datasheet power on values, and 25.25 degrees
+  memset(rtc, 0, sizeof(rtc));
+  rtc[3]      = 0x01;
+  rtc[4]      = 0x01;
+  rtc[5]      = 0x01;
+  rtc[0xE]    = 0x1C;
+  rtc[0xF]    = 0x88;
+  rtc[0x11]   = 0x19;
+  rtc[0x12]   = 0x40;
+  rtcPointer  = 0;
+  temperature = 101;
+  conversions = 0;
+  alarm1Fires = 0;
+  alarm2Fires = 0;
+
+  rtcSeconds     = 0;
+  rtcSecondsAt   = now;
+  conversionDone = 0;
+
+  memset(eeprom, 0xFF, sizeof(eeprom));
+  memset(eepromPageWrites, 0, sizeof(eepromPageWrites));
+  eepromSize      = DS3231_EEPROM_SIZE_KBIT * 128UL;
+  eepromPageSize  = DS3231_EEPROM_PAGE_SIZE;
+  eepromAddress   = DS3231_EEPROM_ADDRESS;
+  eepromPointer   = 0;
+  eepromBusyUntil = 0;
+
+  interruptHandler = 0;
+}
+
+void Simulator::resetCounters()
+{
+  transactions = 0;
+  bytes        = 0;
+  nacks        = 0;
+  eepromReads  = 0;
+  writeCycles  = 0;
+  pinsTakenFromWire = 0;
+}
+
+void Simulator::advance(unsigned long Micros)
+{
+  passTime(Micros);
+  updateClock();
+}
+
+void Simulator::advanceToNextSecond()
+{
+  updateClock();
+  advance(1000000 - (now - rtcSecondsAt) + 1);
+}
+
+uint32_t Simulator::clockSeconds()
+{
+  updateClock();
+  return rtcSeconds;
+}
+
+void Simulator::setClockSeconds(uint32_t Seconds)
+{
+  updateClock();
+  rtcSeconds   = Seconds;
+  rtcSecondsAt = now;
+  secondsToRegisters(rtcSeconds);
+  rtc[0xF]    &= ~0x80;
+}
+
+void Simulator::passTime(unsigned long Micros)
+{
+  now += Micros;
+}
+
+void Simulator::updateClock()
+{
+  // A temperature conversion finishing
+  if((rtc[0xE] & 0x20) && now >= conversionDone)
+  {
+    rtc[0xE] &= ~0x20;
+    rtc[0xF] &= ~0x04;
+    rtc[0x11] = (uint8_t)(temperature >> 2);
+    rtc[0x12] = (uint8_t)((temperature & 3) << 6);
+    conversions++;
+  }
+
+  // Every second is ticked over on its own, alarms need to see each of them
+  while(now - rtcSecondsAt >= 1000000)
+  {
+    rtcSecondsAt += 1000000;
+    tickSecond();
+  }
+}
+
+void Simulator::tickSecond()
+{
+  rtcSeconds++;
+  secondsToRegisters(rtcSeconds);
+
+  // The day of the week is just a counter, 1 to 7, which goes on at midnight
+  if(!(rtcSeconds % 86400UL))
+  {
+    rtc[3] = rtc[3] >= 7 ? 1 : rtc[3] + 1;
+  }
+
+  const uint8_t OldStatus = rtc[0xF];
+
+  if(alarmMatches(&rtc[0x7], 1))
+  {
+    rtc[0xF] |= 0x01;
+    alarm1Fires++;
+  }
+
+  if(!(rtcSeconds % 60) && alarmMatches(&rtc[0xB], 0))
+  {
+    rtc[0xF] |= 0x02;
+    alarm2Fires++;
+  }
+
+  if(!interruptHandler) return;
+
+  if(rtc[0xE] & 0x04)
+  {
+    // INTCN, the pin goes low when an enabled alarm's flag is set
+    if((rtc[0xF] & ~OldStatus) & rtc[0xE] & 0x03) interruptHandler();
+  }
+  else if(!(rtc[0xE] & 0x18))
+  {
+    // 1Hz square wave, the falling edge is at the start of the second
+    interruptHandler();
+  }
+}
+
+uint8_t Simulator::alarmMatches(const uint8_t *Alarm, const uint8_t HasSeconds)
+{
+  if(HasSeconds)
+  {
+    if(!(Alarm[0] & 0x80) && fromBcd(Alarm[0] & 0x7F) != fromBcd(rtc[0])) return 0;
+    Alarm++;
+  }
+
+  if(!(Alarm[0] & 0x80) && fromBcd(Alarm[0] & 0x7F) != fromBcd(rtc[1])) return 0;
+  if(!(Alarm[1] & 0x80) && fromBcd(Alarm[1] & 0x3F) != fromBcd(rtc[2] & 0x3F)) return 0;
+
+  if(!(Alarm[2] & 0x80))
+  {
+    if(Alarm[2] & 0x40)
+    {
+      if((Alarm[2] & 0x0F) != rtc[3]) return 0;
+    }
+    else if(fromBcd(Alarm[2] & 0x3F) != fromBcd(rtc[4]))
+    {
+      return 0;
+    }
+  }
+
+  return 1;
+}
+
+void Simulator::writeRegister(const uint8_t Register, const uint8_t Value)
+{
+  switch(Register)
+  {
+    case 0xE:
+      // CONV stays set until the conversion is done, and starting one sets BSY
+      if((Value & 0x20) && !(rtc[0xE] & 0x20))
+      {
+        rtc[0xF]      |= 0x04;
+        conversionDone = now + CONVERSION_MICROS;
+      }
+      rtc[0xE] = Value | (rtc[0xE] & 0x20);
+      break;
+
+    case 0xF:
+      // OSF, A2F and A1F can only be cleared, EN32kHz is read/write, BSY is read only
+      rtc[0xF] = (rtc[0xF] & Value & 0x83) | (Value & 0x08) | (rtc[0xF] & 0x04);
+      break;
+
+    case 0x11:
+    case 0x12:
+      // Temperature, read only
+      break;
+
+    default:
+      rtc[Register] = Value;
+      break;
+  }
+}
+
+uint8_t Simulator::injectFault()
+{
+  if(!failNext) return 0;
+
+  if(failAfter)
+  {
+    failAfter--;
+    return 0;
+  }
+
+  failNext--;
+  nacks++;
+  return 1;
+}
+
+uint8_t Simulator::write(const uint8_t Address, const uint8_t *Data, const uint8_t Length)
+{
+  transactions++;
+  bytes += Length + 1;
+  passTime((Length + 1) * BYTE_MICROS);
+
+  if(injectFault()) return 2;
+
+  if(Address == RTC_ADDRESS)
+  {
+    if(!Length) return 0;
+
+    updateClock();
+    rtcPointer = Data[0] % sizeof(rtc);
+
+    uint8_t SetTime = 0;
+    for(uint8_t i = 1; i < Length; i++)
+    {
+      if(rtcPointer < 7) SetTime = 1;
+      writeRegister(rtcPointer, Data[i]);
+      rtcPointer = (rtcPointer + 1) % sizeof(rtc);
+    }
+
+    // Writing the time starts the second again
+    if(SetTime)
+    {
+      rtcSeconds   = registersToSeconds();
+      rtcSecondsAt = now;
+    }
+    return 0;
+  }
+
+  if(Address == eepromAddress)
+  {
+    if(now < eepromBusyUntil)
+    {
+      nacks++;
+      return 2;
+    }
+
+    if(!Length) return 0;                       // Acknowledge polling
+    if(Length < 2) return 4;
+
+    eepromPointer = (((uint32_t)Data[0] << 8) | Data[1]) % eepromSize;
+    if(Length > 2)
+    {
+      const uint32_t Page = eepromPointer - (eepromPointer % eepromPageSize);
+      for(uint8_t i = 2; i < Length; i++)
+      {
+        eeprom[Page + (eepromPointer - Page + i - 2) % eepromPageSize] = Data[i];
+      }
+      eepromPageWrites[Page / eepromPageSize]++;
+      eepromBusyUntil = now + EEPROM_WRITE_MICROS;
+      writeCycles++;
+    }
+    return 0;
+  }
+
+  nacks++;
+  return 2;
+}
+
+uint8_t Simulator::read(const uint8_t Address, uint8_t *Data, const uint8_t Length)
+{
+  // Only the address byte if it is not acknowledged
+  transactions++;
+  bytes++;
+  passTime(BYTE_MICROS);
+
+  if(injectFault()) return 0;
+
+  if(Address == RTC_ADDRESS)
+  {
+    bytes += Length;
+    passTime(Length * BYTE_MICROS);
+    updateClock();
+    for(uint8_t i = 0; i < Length; i++)
+    {
+      Data[i]    = rtc[rtcPointer];
+      rtcPointer = (rtcPointer + 1) % sizeof(rtc);
+    }
+    return Length;
+  }
+
+  if(Address == eepromAddress)
+  {
+    if(now < eepromBusyUntil)
+    {
+      nacks++;
+      return 0;
+    }
+
+    eepromReads++;
+    bytes += Length;
+    passTime(Length * BYTE_MICROS);
+    for(uint8_t i = 0; i < Length; i++)
+    {
+      Data[i]       = eeprom[eepromPointer];
+      eepromPointer = (eepromPointer + 1) % eepromSize;
+    }
+    return Length;
+  }
+
+  nacks++;
+  return 0;
+}
@@ -0,0 +1,128 @@
+// A simulated I2C bus with a DS3231 and an AT24C32 (family) EEPROM on it, so that
+// DS3231_Simple can be built, tested and measured on a PC.
+//
+//  * The DS3231 has all its registers (0x00 to 0x12).  The time counts on from the
+//    simulated time, the alarms set their flags as their second comes around, the
+//    status flags behave as the datasheet says (OSF set at power on, A1F/A2F can only
+//    be cleared, BSY read only) and a temperature conversion takes CONVERSION_MICROS.
+//    While INTCN is clear the 1Hz square wave's falling edge, at the start of each
+//    second, calls the handler given to attachInterrupt().
+//
+//  * The EEPROM does page writes (wrapping within the page like the real thing),
+//    then does not acknowledge anything for EEPROM_WRITE_MICROS while it writes them.
+//    Reads go on sequentially, wrapping at the top.
+//
+//  * Every byte on the bus, including the address byte, takes BYTE_MICROS (100kHz).
+//    The simulated time only passes on the bus, in delay() and delayMicroseconds(),
+//    and when a test calls advance(), so results are exactly repeatable.
+//
+// Everything a test wants to look at or poke (registers, EEPROM contents, counters,
+// failNext for injecting faults) is public, there is one global Simulator "sim".
+
+#ifndef HOST_SIMULATOR_H
+#define HOST_SIMULATOR_H
+
+#include <stdint.h>
+#include <atomic>
+
+class Simulator
+{
+  public:
+    static const unsigned long BYTE_MICROS         = 90;       // 9 clocks at 100kHz
+    static const unsigned long EEPROM_WRITE_MICROS = 5000;     // AT24C32 datasheet tWR
+    static const unsigned long CONVERSION_MICROS   = 150000;   // DS3231 datasheet tCONV is 125-200mS
+
+    static const uint8_t       RTC_ADDRESS         = 0x68;
+
+    Simulator() { powerOn(); }
+
+    /** Everything back as a brand new module, EEPROM erased (0xFF), the clock at
+     *  2000-01-01 00:00:00 with the Oscillator Stop Flag set, and the counters zeroed.
+     */
+
+    void powerOn();
+
+    /** Zero the counters, so that what follows can be measured (except overflows,
+     *  which only powerOn() zeroes).
+     */
+
+    void resetCounters();
+
+    /** Let time pass (as if the MCU were busy, or asleep, not using the bus).
+     */
+
+    void advance(unsigned long Micros);
+
+    /** Let time pass up to just after the start of the next second of the clock.
+     */
+
+    void advanceToNextSecond();
+
+    /** Seconds since 2000-01-01 00:00:00 on the clock now.
+     */
+
+    uint32_t clockSeconds();
+
+    /** Set the clock (as if set by another MCU), and clear OSF.
+     */
+
+    void setClockSeconds(uint32_t Seconds);
+
+    // The simulated time, atomic only so that other threads can read millis()
+    std::atomic<unsigned long> now;
+
+    // Counters, see resetCounters()
+    unsigned long transactions;               // Every address sent, acknowledged or not
+    unsigned long bytes;                      // Bytes on the bus including the address bytes
+    unsigned long nacks;                      // Transactions not acknowledged (the EEPROM busy writing, and faults)
+    unsigned long eepromReads;                // Acknowledged reads of the EEPROM, each is a "probe" of it
+    unsigned long writeCycles;                // EEPROM page writes
+    unsigned long overflows;                  // Writes to Wire beyond its BUFFER_LENGTH (a library bug)
+    unsigned long pinsTakenFromWire;          // pinMode()/digitalWrite() while Wire has the pins (a library bug)
+
+    // Fault injection, failNext transactions are not acknowledged, after failAfter which are
+    unsigned      failNext;
+    unsigned      failAfter;
+
+    // DS3231
+    uint8_t       rtc[0x13];
+    uint8_t       rtcPointer;
+    int16_t       temperature;                // Quarter degrees, the result of the next conversion
+    unsigned long conversions;
+    unsigned long alarm1Fires;
+    unsigned long alarm2Fires;
+
+    // EEPROM
+    uint8_t       eeprom[65536];
+    uint32_t      eepromSize;                 // Bytes, 4096 for an AT24C32
+    uint16_t      eepromPageSize;             // Bytes, 32 for an AT24C32
+    uint8_t       eepromAddress;
+    uint16_t      eepromPointer;
+    unsigned long eepromBusyUntil;
+    unsigned long eepromPageWrites[2048];     // Writes of each page (wear)
+
+    // Bus, called by TwoWire
+    uint8_t write(const uint8_t Address, const uint8_t *Data, const uint8_t Length);
+    uint8_t read(const uint8_t Address, uint8_t *Data, const uint8_t Length);
+
+    void  (*interruptHandler)();
+
+  protected:
+    uint8_t  injectFault();
+
+    uint32_t      rtcSeconds;                 // The clock at rtcSecondsAt
+    unsigned long rtcSecondsAt;               // now at the start of that second
+    unsigned long conversionDone;
+
+    void     passTime(unsigned long Micros);
+    void     updateClock();
+    void     tickSecond();
+    void     writeRegister(const uint8_t Register, const uint8_t Value);
+    uint8_t  alarmMatches(const uint8_t *Alarm, const uint8_t HasSeconds);
+    void     secondsToRegisters(uint32_t Seconds);
+    uint32_t registersToSeconds();
+};
+
+extern Simulator sim;
+
+#endif
@@ -0,0 +1,117 @@
+// The simulated DS3231 and EEPROM behave as the datasheets say, the other tests
+// depend on it.
+
+#include "Wire.h"
+#include "HostTest.h"
+
+static uint8_t readRtc(const uint8_t Register)
+{
+  Wire.beginTransmission(Simulator::RTC_ADDRESS);
+  Wire.write(Register);
+  Wire.endTransmission();
+  Wire.requestFrom(Simulator::RTC_ADDRESS, (uint8_t) 1);
+  return Wire.read();
+}
+
+static void writeRtc(const uint8_t Register, const uint8_t Value)
+{
+  Wire.beginTransmission(Simulator::RTC_ADDRESS);
+  Wire.write(Register);
+  Wire.write(Value);
+  Wire.endTransmission();
+}
+
+static unsigned edges = 0;
+static void onEdge() { edges++; }
+
+int main()
+{
+  // Power on values
+  CHECK(readRtc(0xE) == 0x1C);
+  CHECK(readRtc(0xF) == 0x88);
+  CHECK(readRtc(0x4) == 0x01);
+
+  // The clock runs, and goes over the end of a (leap) month
+  sim.setClockSeconds(59UL * 86400 - 1);          // 2000-02-28 23:59:59
+  CHECK(readRtc(0x0) == 0x59);
+  sim.advance(1000000);
+  CHECK(readRtc(0x4) == 0x29 && readRtc(0x5) == 0x02 && readRtc(0x2) == 0x00);
+  CHECK(readRtc(0x3) == 0x02);                    // Day of week counted on at midnight
+
+  // Setting the time in the registers
+  writeRtc(0x6, 0x21);
+  CHECK(sim.clockSeconds() > 365UL * 21 * 86400);
+
+  // Status, OSF and the alarm flags can only be cleared, BSY is read only
+  CHECK(readRtc(0xF) == 0x08);                    // setClockSeconds() cleared OSF
+  writeRtc(0xF, 0xFF);
+  CHECK(readRtc(0xF) == 0x08);
+  writeRtc(0xF, 0x00);
+  CHECK(readRtc(0xF) == 0x00);
+
+  // Alarm 1 once a second, flag set each second
+  writeRtc(0x7, 0x80); writeRtc(0x8, 0x80); writeRtc(0x9, 0x80); writeRtc(0xA, 0x80);
+  sim.advanceToNextSecond();
+  CHECK(readRtc(0xF) & 0x01);
+  CHECK(sim.alarm1Fires == 1);
+
+  // Alarm 2 once a minute, at 00 seconds only
+  writeRtc(0xB, 0x80); writeRtc(0xC, 0x80); writeRtc(0xD, 0x80);
+  for(uint8_t x = 0; x < 60; x++) sim.advanceToNextSecond();
+  CHECK(sim.alarm2Fires == 1);
+  CHECK(readRtc(0xF) & 0x02);
+
+  // Square wave edges only while INTCN is clear, alarm interrupts only while set
+  attachInterrupt(2, onEdge, FALLING);
+  writeRtc(0xE, 0x00);
+  sim.advanceToNextSecond();
+  sim.advanceToNextSecond();
+  CHECK(edges == 2);
+  writeRtc(0xE, 0x05);                            // INTCN and A1IE
+  writeRtc(0xF, 0x00);
+  sim.advanceToNextSecond();
+  CHECK(edges == 3);
+  sim.advanceToNextSecond();                      // Still low, A1F was not cleared
+  CHECK(edges == 3);
+  writeRtc(0xE, 0x04);
+  writeRtc(0xF, 0x00);
+  sim.advanceToNextSecond();
+  CHECK(edges == 3);
+  detachInterrupt(2);
+
+  // Temperature conversion, BSY until done
+  writeRtc(0xE, 0x24);
+  CHECK(readRtc(0xF) & 0x04);
+  sim.temperature = -10;
+  sim.advance(Simulator::CONVERSION_MICROS);
+  CHECK(!(readRtc(0xF) & 0x04) && !(readRtc(0xE) & 0x20));
+  CHECK(readRtc(0x11) == 0xFD && readRtc(0x12) == 0x80);
+
+  // EEPROM page writes wrap within the page, and it is busy after
+  Wire.beginTransmission(sim.eepromAddress);
+  Wire.write(0); Wire.write(30);
+  Wire.write(1); Wire.write(2); Wire.write(3);
+  CHECK(Wire.endTransmission() == 0);
+  CHECK(sim.eeprom[30] == 1 && sim.eeprom[31] == 2 && sim.eeprom[0] == 3 && sim.eeprom[32] == 0xFF);
+  Wire.beginTransmission(sim.eepromAddress);
+  CHECK(Wire.endTransmission() != 0);
+  sim.advance(Simulator::EEPROM_WRITE_MICROS);
+  Wire.beginTransmission(sim.eepromAddress);
+  CHECK(Wire.endTransmission() == 0);
+
+  // Sequential reads wrap at the top
+  sim.eeprom[sim.eepromSize - 1] = 9;
+  Wire.beginTransmission(sim.eepromAddress);
+  Wire.write((uint8_t)((sim.eepromSize - 1) >> 8)); Wire.write((uint8_t)(sim.eepromSize - 1));
+  Wire.endTransmission();
+  CHECK(Wire.requestFrom(sim.eepromAddress, (uint8_t) 2) == 2);
+  CHECK(Wire.read() == 9 && Wire.read() == 3);
+
+  // Faults
+  sim.failNext = 1;
+  CHECK(Wire.requestFrom(Simulator::RTC_ADDRESS, (uint8_t) 1) == 0);
+  CHECK(Wire.requestFrom(Simulator::RTC_ADDRESS, (uint8_t) 1) == 1);
+
+  CHECK(!sim.overflows);
+  return failures;
+}
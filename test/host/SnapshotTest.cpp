@@ -0,0 +1,75 @@
+// snapshot() reads the time, alarm flags and temperature in one read, and what is
+// worked out from it agrees with read(), checkAlarms() and getTemperature...(), with
+// only the flags it saw cleared.
+
+#include "DS3231_Simple.h"
+#include "HostTest.h"
+
+typedef DS3231_Simple S;
+
+int main()
+{
+  S            Clock;
+  S::Snapshot  Snap;
+  DateTime     Now;
+  Measure      Cost;
+
+  DateTime Start;
+  Start.Year = 22; Start.Month = 12; Start.Day = 31; Start.Dow = 7;
+  Start.Hour = 23; Start.Minute = 59; Start.Second = 50;
+
+  CHECK(Clock.begin());
+  CHECK(Clock.write(Start));
+  sim.temperature = -23;
+  CHECK(Clock.startTemperatureConversion());
+  while(!Clock.temperatureReady()) sim.advance(10000);
+  CHECK(Clock.getTemperatureQuarters() == -23);
+
+  // Seek and one read, the same as read() and the temperature says
+  Cost.start();
+  CHECK(Clock.snapshot(Snap));
+  Cost.stop();
+  CHECK(Cost.transactions == 2);
+  CHECK(sim.conversions == 1);
+  CHECK(Clock.read(Now));
+  CHECK(S::toEpoch(Snap.Time) == S::toEpoch(Now) && Snap.Time.Year == Now.Year && Snap.Time.Dow == Now.Dow);
+  CHECK(Clock.getTemperatureQuarters(Snap) == -23);
+  CHECK(Clock.getTemperatureCentidegrees(Snap) == -575);
+  CHECK(Clock.getTemperature(Snap) == -6);
+  CHECK(Clock.getTemperatureFloat(Snap) == -5.75);
+  CHECK(Snap.Control == sim.rtc[0xE] && Snap.Status == sim.rtc[0xF]);
+  CHECK(!Snap.Alarms);
+
+  // No alarm, nothing written
+  Cost.start();
+  CHECK(!Clock.checkAlarms(Snap));
+  Cost.stop();
+  CHECK(!Cost.transactions);
+
+  // Alarm 1 seen, and cleared, alarm 2 firing after the snapshot is left for next time
+  CHECK(Clock.setAlarm(S::ALARM_EVERY_SECOND));
+  sim.advanceToNextSecond();
+  CHECK(Clock.snapshot(Snap));
+  CHECK(Snap.Alarms == 1);
+  sim.rtc[0xF] |= 0x02;
+  Cost.start();
+  CHECK(Clock.checkAlarms(Snap) == 1);
+  Cost.stop();
+  CHECK(Cost.transactions == 1);
+  CHECK((sim.rtc[0xF] & 0x03) == 0x02);
+  CHECK(Clock.checkAlarms() == 2);
+
+  // Left alone when asked
+  sim.advanceToNextSecond();
+  CHECK(Clock.snapshot(Snap) && Snap.Alarms == 1);
+  CHECK(Clock.checkAlarms(Snap, false) == 1);
+  CHECK(sim.rtc[0xF] & 0x01);
+
+  // Nothing from a clock which doesn't answer
+  sim.failNext = DS3231_I2C_RETRIES + 1;
+  CHECK(!Clock.snapshot(Snap));
+  CHECK(Clock.getLastError());
+
+  CHECK(!sim.overflows);
+  return failures;
+}
@@ -0,0 +1,128 @@
+// USE_STATISTICS: what the library counts for each kind of call agrees with what the
+// simulator saw on the bus, transactions, bytes and NACKs, with EEPROM write polls,
+// retries and failures among them.  Built as well with USE_SELECTABLE_WIRE (counting
+// through the chosen buses) and USE_ASYNC_REQUESTS (the queue's own calls).
+
+#include "DS3231_Simple.h"
+#include "HostTest.h"
+
+#ifndef USE_STATISTICS
+  #error "Build with -DUSE_STATISTICS"
+#endif
+
+static const unsigned ATTEMPTS = DS3231_I2C_RETRIES + 1;
+
+static DS3231_Simple Clock;
+
+#ifdef USE_ASYNC_REQUESTS
+static uint8_t requestsDone = 0;
+static void    requestDone(const DS3231_Simple::Request &Done) { if(Done.Success) requestsDone++; }
+#endif
+
+int main()
+{
+  typedef DS3231_Simple S;
+  DateTime Now;
+  DateTime Logged;
+  uint16_t Data;
+
+#ifdef USE_SELECTABLE_WIRE
+  // The clock on Wire1, the EEPROM on Wire, counted all the same
+  Clock.setWire(Wire1, Wire);
+#endif
+  Clock.begin();
+  Clock.formatEEPROM(S::FORMAT_FAST);
+
+  Clock.resetStatistics();
+  sim.resetCounters();
+
+  // Some of everything, with the EEPROM busy after each page write so there are polls
+  for(uint8_t x = 0; x < 10; x++) CHECK(Clock.read(Now));
+  CHECK(Clock.write(Now));
+  CHECK(Clock.setAlarm(S::ALARM_EVERY_SECOND));
+  Clock.checkAlarms();
+  CHECK(Clock.disableAlarms());
+  Clock.getTemperature();
+  for(uint16_t x = 0; x < 20; x++)
+  {
+    S::addSeconds(Now, 1);
+    CHECK(Clock.writeLog(Now, x));
+  }
+  for(uint16_t x = 0; x < 20; x++) CHECK(Clock.readLog(Logged, Data) && Data == x);
+  CHECK(Clock.formatEEPROM(S::FORMAT_FULL));
+
+#ifdef USE_ASYNC_REQUESTS
+  CHECK(Clock.requestRead(requestDone));
+  CHECK(Clock.requestTemperature(requestDone));
+  while(Clock.serviceRequests() != S::REQUESTS_IDLE);
+  CHECK(requestsDone == 2);
+#endif
+
+  // A transient fault (one retry), and a lasting one (all the retries, then fails)
+  sim.failNext = 1;
+  CHECK(Clock.read(Now));
+  sim.failNext = ATTEMPTS;
+  CHECK(!Clock.read(Now));
+  Clock.getLastError();
+
+  const S::Statistics &Stats = Clock.getStatistics();
+  unsigned long Transactions = 0, Bytes = 0, Nacks = 0, Polls = 0, Retries = 0;
+  for(uint8_t x = 0; x < S::STATS_APIS; x++)
+  {
+    const S::ApiStatistics &Api = Stats.Api[x];
+    Transactions += Api.Transactions;
+    Bytes        += Api.Bytes;
+    Nacks        += Api.Nacks;
+    Polls        += Api.Polls;
+    Retries      += Api.Retries;
+
+    // Every call lands in one latency bucket
+    unsigned long Latencies = 0;
+    for(uint8_t y = 0; y < S::STATS_LATENCY_BUCKETS; y++) Latencies += Api.Latency[y];
+    CHECK(Latencies == Api.Calls);
+    CHECK(Api.Polls <= Api.Nacks);
+  }
+
+  printf("statistics,transactions %lu (bus %lu),bytes %lu (bus %lu less addresses),NACKs %lu (bus %lu),polls %lu,retries %lu\n",
+         Transactions, sim.transactions, Bytes, sim.bytes - sim.transactions, Nacks, sim.nacks, Polls, Retries);
+
+  // The simulator counts the address byte of each transaction, the library doesn't
+  CHECK(Transactions == sim.transactions);
+  CHECK(Bytes        == sim.bytes - sim.transactions);
+  CHECK(Nacks        == sim.nacks);
+  CHECK(Retries      == 1 + DS3231_I2C_RETRIES);
+
+  // Each call counted once, against the call made, not what it calls
+#ifdef USE_ASYNC_REQUESTS
+  // The queued read counted as a read(), the temperature polls each as a call
+  CHECK(Stats.Api[S::STATS_READ].Calls      == 13);
+  CHECK(Stats.Api[S::STATS_TEMPERATURE].Calls > 2);
+#else
+  CHECK(Stats.Api[S::STATS_READ].Calls      == 12);
+  CHECK(Stats.Api[S::STATS_TEMPERATURE].Calls == 1);
+#endif
+  CHECK(!Stats.Api[S::STATS_OTHER].Transactions);
+  CHECK(Stats.Api[S::STATS_READ].Nacks      == 1 + ATTEMPTS);
+  CHECK(Stats.Api[S::STATS_WRITE].Calls     == 1);
+  CHECK(Stats.Api[S::STATS_ALARMS].Calls    == 3);
+  CHECK(Stats.Api[S::STATS_WRITE_LOG].Calls == 20);
+  CHECK(Stats.Api[S::STATS_WRITE_LOG].Polls > 0);
+  CHECK(Stats.Api[S::STATS_READ_LOG].Calls  == 20);
+  CHECK(Stats.Api[S::STATS_FORMAT].Calls    == 1);
+  CHECK(Stats.Api[S::STATS_FORMAT].Polls > 0);
+  CHECK(Stats.Current == S::STATS_NONE);
+
+#ifdef USE_SELECTABLE_WIRE
+  // All of the clock's traffic went through Wire1, and the EEPROM's through Wire
+  CHECK(Wire1.rtcTransactions && !Wire1.eepromTransactions);
+  CHECK(Wire.eepromTransactions && !Wire.rtcTransactions);
+#endif
+
+  Clock.printStats(Serial);
+
+  Clock.resetStatistics();
+  for(uint8_t x = 0; x < S::STATS_APIS; x++) CHECK(!Stats.Api[x].Calls && !Stats.Api[x].Transactions);
+
+  CHECK(!sim.overflows);
+  return failures;
+}
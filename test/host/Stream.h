@@ -0,0 +1,2 @@
+// Stream is in Arduino.h on the host
+#include "Arduino.h"
@@ -0,0 +1,119 @@
+// USE_LOG_SUPERBLOCK: the checkpoints share the wear of the 8 superblock pages, and
+// after a reset the log picks up from them exactly where it was, also when the reader
+// has consumed entries written since the last checkpoint.
+
+#include "DS3231_Simple.h"
+#include "HostTest.h"
+
+#ifndef USE_LOG_SUPERBLOCK
+  #error "Build with -DUSE_LOG_SUPERBLOCK"
+#endif
+
+static DS3231_Simple *Clock;
+static DateTime       Timestamp;
+
+static void logEntry(const uint16_t Data)
+{
+  DS3231_Simple::addSeconds(Timestamp, 1);
+  CHECK(Clock->writeLog(Timestamp, Data));
+}
+
+// The entries readLog() gives, From up to To, and then nothing
+static void expectEntries(const uint16_t From, const uint16_t To)
+{
+  DateTime Logged;
+  uint16_t Data;
+  for(uint16_t x = From; x < To; x++)
+  {
+    if(!Clock->readLog(Logged, Data) || Data != x)
+    {
+      failures++;
+      printf("FAILED expected entry %u\n", x);
+      return;
+    }
+  }
+  CHECK(!Clock->readLog(Logged, Data));
+}
+
+static void reset()
+{
+  delete Clock;
+  Clock = new DS3231_Simple;
+}
+
+int main()
+{
+  const uint16_t Pages          = sim.eepromSize / sim.eepromPageSize;
+  const uint16_t SuperblockPage = Pages - 8;
+  DateTime       Logged;
+  uint16_t       Data;
+
+  Clock = new DS3231_Simple;
+  Clock->begin();
+  Clock->read(Timestamp);
+  Clock->formatEEPROM(DS3231_Simple::FORMAT_FULL);
+
+  // A stream of entries each read as soon as it is written, every read consumes an
+  // entry written since the last checkpoint so each read checkpoints
+  memset(sim.eepromPageWrites, 0, sizeof(sim.eepromPageWrites));
+  for(uint16_t x = 0; x < 200; x++)
+  {
+    logEntry(x);
+    CHECK(Clock->readLog(Logged, Data) && Data == x);
+  }
+
+  unsigned long Hottest = 0, HottestLog = 0, Superblock = 0;
+  for(uint16_t p = 0; p < Pages; p++)
+  {
+    if(p >= SuperblockPage)
+    {
+      Superblock += sim.eepromPageWrites[p];
+      if(sim.eepromPageWrites[p] > Hottest) Hottest = sim.eepromPageWrites[p];
+    }
+    else if(sim.eepromPageWrites[p] > HottestLog) HottestLog = sim.eepromPageWrites[p];
+  }
+  printf("200 writes and reads,superblock page writes %lu,hottest superblock page %lu,hottest log page %lu\n", Superblock, Hottest, HottestLog);
+
+  // Spread evenly over the 8 pages
+  CHECK(Hottest <= (Superblock + 7) / 8);
+  for(uint16_t p = SuperblockPage; p < Pages; p++) CHECK(sim.eepromPageWrites[p] + 1 >= Hottest);
+
+  // Reset with nothing read since the last checkpoint
+  for(uint16_t x = 0; x < 30; x++) logEntry(x);
+  reset();
+  expectEntries(0, 30);
+
+  // Reset after reading some of what was written since the last checkpoint, and
+  // writing more after that, nothing is lost or read twice
+  for(uint16_t x = 0; x < 20; x++) logEntry(x);
+  reset();
+  for(uint16_t x = 0; x < 5; x++) CHECK(Clock->readLog(Logged, Data) && Data == x);
+  for(uint16_t x = 20; x < 25; x++) logEntry(x);
+  reset();
+  expectEntries(5, 25);
+
+  // Around the end of the EEPROM, a reset after every few
+  uint16_t Written = 0, Read = 0;
+  for(uint16_t Round = 0; Round < 100; Round++)
+  {
+    for(uint8_t x = 0; x < 7; x++) logEntry(Written++);
+    for(uint8_t x = 0; x < 5; x++)
+    {
+      if(!Clock->readLog(Logged, Data) || Data != Read) { CHECK(0); break; }
+      Read++;
+    }
+    if(!(Round % 3)) reset();
+  }
+  expectEntries(Read, Written);
+
+  // The superblock is not written over by the log
+  for(uint16_t p = SuperblockPage; p < Pages; p++)
+  {
+    const uint8_t *Slot = &sim.eeprom[(uint32_t) p * sim.eepromPageSize];
+    for(uint16_t x = 8; x < sim.eepromPageSize; x++) CHECK(!Slot[x]);
+  }
+
+  CHECK(!sim.overflows);
+  delete Clock;
+  return failures;
+}
@@ -0,0 +1,61 @@
+// Every temperature the clock can give, -128.00 to +127.75: the quarters, centidegrees
+// and float are exact, and getTemperature() rounds half to even (held at 127), read
+// from the clock and from a snapshot alike.
+
+#include "DS3231_Simple.h"
+#include "HostTest.h"
+
+// Whole degrees rounded half to even, the top held at 127
+static int expectedRounded(const int Quarters)
+{
+  int Whole  = Quarters >> 2;
+  int Over   = Quarters & 3;
+  if((Over > 2 || (Over == 2 && (Whole & 1))) && Whole < 127) Whole++;
+  return Whole;
+}
+
+int main()
+{
+  DS3231_Simple           Clock;
+  DS3231_Simple::Snapshot Snap;
+  unsigned                Values = 0;
+
+  CHECK(Clock.begin());
+
+  for(int Quarters = -512; Quarters < 512; Quarters++)
+  {
+    sim.rtc[0x11] = (uint8_t)(Quarters >> 2);
+    sim.rtc[0x12] = (uint8_t)((Quarters & 3) << 6);
+
+    const int16_t Read = Clock.getTemperatureQuarters();
+    CHECK(Clock.snapshot(Snap));
+
+    if(   Read != Quarters
+       || Clock.getTemperatureQuarters(Snap) != Quarters
+       || Clock.getTemperatureCentidegrees() != Quarters * 25
+       || Clock.getTemperatureCentidegrees(Snap) != Quarters * 25
+       || Clock.getTemperatureFloat() != Quarters * 0.25f
+       || Clock.getTemperatureFloat(Snap) != Quarters * 0.25f
+       || Clock.getTemperature() != expectedRounded(Quarters)
+       || Clock.getTemperature(Snap) != expectedRounded(Quarters))
+    {
+      failures++;
+      printf("FAILED %d quarters, read %d, rounded %d\n", Quarters, Read, Clock.getTemperature());
+    }
+    else Values++;
+  }
+  printf("temperatures,%u of 1024 right\n", Values);
+
+  // A few by hand
+  sim.rtc[0x11] = 0xFF; sim.rtc[0x12] = 0x40;   // -0.75
+  CHECK(Clock.getTemperatureQuarters() == -3 && Clock.getTemperature() == -1);
+  sim.rtc[0x11] = 0xE7; sim.rtc[0x12] = 0x80;   // -24.5
+  CHECK(Clock.getTemperatureCentidegrees() == -2450 && Clock.getTemperature() == -24);
+  sim.rtc[0x11] = 0x19; sim.rtc[0x12] = 0x80;   // 25.5
+  CHECK(Clock.getTemperatureCentidegrees() == 2550 && Clock.getTemperature() == 26);
+  sim.rtc[0x11] = 0x7F; sim.rtc[0x12] = 0xC0;   // 127.75
+  CHECK(Clock.getTemperature() == 127);
+
+  CHECK(!sim.overflows);
+  return failures;
+}
@@ -0,0 +1,131 @@
+// USE_THREAD_SAFE_REQUESTS under std::thread: an owner thread servicing the queue,
+// producers queueing log entries and reads as fast as they can, and readers of the
+// shared time.  Nothing lost, duplicated or reordered (for each producer), and the
+// shared time always whole and within a second of the clock.
+
+#include "DS3231_Simple.h"
+#include "HostTest.h"
+#include <thread>
+#include <atomic>
+#include <vector>
+
+static const int PRODUCERS = 4;
+static const int ENTRIES   = 1500;            // Each, in a 64K EEPROM
+static const int READERS   = 2;
+
+static DS3231_Simple       Clock;
+static std::atomic<int>    logged(0), reads(0), readFailures(0), torn(0), wrong(0), queueFull(0);
+static std::atomic<long>   sharedReads(0);
+static std::atomic<bool>   stop(false);
+static DS3231_Simple::Epoch started;
+
+static void owner()
+{
+  for(;;)
+  {
+    const uint8_t Busy = Clock.serviceRequests();
+
+    // Only this thread uses the bus, so only it can look at the simulated clock
+    DateTime Now;
+    if(Clock.readShared(Now))
+    {
+      const int32_t Behind = (int32_t)(sim.clockSeconds() - DS3231_Simple::toEpoch(Now));
+      if(Behind < -1 || Behind > 1) wrong++;
+    }
+
+    if(Busy == DS3231_Simple::REQUESTS_IDLE)
+    {
+      if(stop) return;
+      std::this_thread::yield();
+    }
+  }
+}
+
+static void producer(const int Producer)
+{
+  for(int x = 0; x < ENTRIES; x++)
+  {
+    DateTime Now;
+    while(!Clock.readShared(Now)) std::this_thread::yield();
+
+    const uint16_t Data = (Producer << 12) | x;
+    while(!Clock.requestLog(Now, Data, [](const DS3231_Simple::Request &Done) { if(Done.Success) logged++; }))
+    {
+      queueFull++;
+      std::this_thread::yield();
+    }
+
+    if(!(x % 50))
+    {
+      while(!Clock.requestRead([](const DS3231_Simple::Request &Done) { if(Done.Success) reads++; else readFailures++; }))
+      {
+        std::this_thread::yield();
+      }
+    }
+  }
+}
+
+static void reader()
+{
+  DS3231_Simple::Epoch Last = 0;
+  while(!stop)
+  {
+    DateTime Now;
+    if(!Clock.readShared(Now)) continue;
+    sharedReads++;
+
+    // A torn copy would be some other time, or out of order.  Counting on with
+    // millis() can be up to a second ahead of the clock when it is next read (the
+    // clock's second started before millis() was taken), so it can step back one.
+    const DS3231_Simple::Epoch Seconds = DS3231_Simple::toEpoch(Now);
+    if(Seconds < started || Seconds > started + 3600 || Seconds + 1 < Last) torn++;
+    Last = Seconds;
+  }
+}
+
+int main()
+{
+  DateTime Start;
+  Start.Year = 20; Start.Month = 10; Start.Day = 3; Start.Dow = 6;
+  Start.Hour = 14; Start.Minute = 17; Start.Second = 30;
+  started = DS3231_Simple::toEpoch(Start);
+
+  Clock.begin();
+  Clock.write(Start);
+  Clock.formatEEPROM(DS3231_Simple::FORMAT_FAST);
+
+  std::thread              Owner(owner);
+  std::vector<std::thread> Producers, Readers;
+  for(int x = 0; x < PRODUCERS; x++) Producers.emplace_back(producer, x);
+  for(int x = 0; x < READERS; x++)   Readers.emplace_back(reader);
+
+  for(auto &t : Producers) t.join();
+  stop = true;
+  Owner.join();
+  for(auto &t : Readers) t.join();
+
+  // Everything logged, each producer's entries in its order
+  int      Next[PRODUCERS] = { 0 };
+  int      ReadBack        = 0;
+  DateTime Logged;
+  uint16_t Data;
+  while(Clock.readLog(Logged, Data))
+  {
+    const int Producer = Data >> 12;
+    if(Producer >= PRODUCERS || (Data & 0xFFF) != Next[Producer]) { CHECK(0); break; }
+    Next[Producer]++;
+    ReadBack++;
+  }
+
+  printf("logged %d,read back %d,reads %d,shared reads %ld,queue full %d\n",
+         (int) logged, ReadBack, (int) reads, (long) sharedReads, (int) queueFull);
+
+  CHECK(logged == PRODUCERS * ENTRIES);
+  CHECK(ReadBack == PRODUCERS * ENTRIES);
+  CHECK(reads == PRODUCERS * (ENTRIES / 50));
+  CHECK(!readFailures);
+  CHECK(!torn);
+  CHECK(!wrong);
+  CHECK(!sim.overflows);
+  return failures;
+}
@@ -0,0 +1,66 @@
+// enableSquareWave() sets only the rate and INTCN, and enableTick() counts the 1Hz
+// edges with the interrupt: ticked() and getTicks() then tell the seconds apart
+// without using the bus at all.
+
+#include "DS3231_Simple.h"
+#include "HostTest.h"
+
+typedef DS3231_Simple S;
+
+static const uint8_t SQW_PIN = 2;
+
+static unsigned long callbacks = 0;
+static void onTick() { callbacks++; }
+
+int main()
+{
+  S Clock;
+
+  CHECK(Clock.begin());
+  CHECK(sim.rtc[0xE] == 0x07);
+
+  // Each rate, the oscillator and alarm interrupt enables left alone
+  const uint8_t Rates[] = { S::SQW_1024HZ, S::SQW_4096HZ, S::SQW_8192HZ, S::SQW_1HZ };
+  for(uint8_t x = 0; x < sizeof(Rates); x++)
+  {
+    CHECK(Clock.enableSquareWave(Rates[x]));
+    CHECK(sim.rtc[0xE] == (Rates[x] | 0x03));
+  }
+  CHECK(Clock.disableSquareWave());
+  CHECK(sim.rtc[0xE] & 0x04);
+
+  // 10 seconds polled every mS, every second ticked and called back, no I2C
+  CHECK(Clock.enableTick(SQW_PIN, S::SQW_1HZ, onTick));
+  CHECK(!(sim.rtc[0xE] & 0x04) && sim.interruptHandler);
+  sim.advanceToNextSecond();
+  Clock.ticked();
+  const uint32_t Start = Clock.getTicks();
+  callbacks = 0;
+
+  sim.resetCounters();
+  uint32_t Ticked = 0;
+  for(unsigned x = 0; x < 10000; x++)
+  {
+    sim.advance(1000);
+    Ticked += Clock.ticked();
+  }
+  printf("10s polling ticked(),%u ticks,%lu callbacks,%lu transactions\n", (unsigned) Ticked, callbacks, sim.transactions);
+  CHECK(Ticked == 10 && callbacks == 10);
+  CHECK(Clock.getTicks() - Start == 10);
+  CHECK(!sim.transactions);
+  CHECK(!Clock.ticked());
+
+  // Stopped, the square wave carries on but nothing counts it
+  Clock.disableTick();
+  CHECK(!sim.interruptHandler);
+  CHECK(!(sim.rtc[0xE] & 0x04));
+  sim.advance(3000000);
+  CHECK(!Clock.ticked() && Clock.getTicks() - Start == 10);
+
+  // Setting an alarm takes SQW back for the alarms
+  CHECK(Clock.setAlarm(S::ALARM_EVERY_MINUTE));
+  CHECK(sim.rtc[0xE] & 0x04);
+
+  CHECK(!sim.overflows);
+  return failures;
+}
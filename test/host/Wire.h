@@ -0,0 +1,69 @@
+// The Wire library, as far as DS3231_Simple uses it, talking to the devices of
+// the simulator (see Simulator.h) instead of real ones.
+
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include "Arduino.h"
+
+#ifndef BUFFER_LENGTH
+#define BUFFER_LENGTH 32
+#endif
+
+// Like the AVR Wire, it has end()
+#define WIRE_HAS_END 1
+
+class TwoWire : public Stream
+{
+  public:
+    void    begin();
+    void    end()                        { enabled = 0; }
+    void    setClock(uint32_t Frequency) { (void) Frequency; }
+
+    void    beginTransmission(uint8_t Address);
+    void    beginTransmission(int Address)                    { beginTransmission((uint8_t) Address); }
+    uint8_t endTransmission(uint8_t SendStop);
+    uint8_t endTransmission()                                 { return endTransmission(1); }
+
+    uint8_t requestFrom(uint8_t Address, uint8_t Quantity, uint8_t SendStop);
+    uint8_t requestFrom(uint8_t Address, uint8_t Quantity)    { return requestFrom(Address, Quantity, 1); }
+    uint8_t requestFrom(int Address, int Quantity)            { return requestFrom((uint8_t) Address, (uint8_t) Quantity, 1); }
+
+    size_t  write(uint8_t Data);
+    size_t  write(const uint8_t *Data, size_t Quantity)
+    {
+      size_t n = 0;
+      while(Quantity--) n += write(*Data++);
+      return n;
+    }
+    using   Print::write;
+    size_t  write(int Data)           { return write((uint8_t) Data); }
+    size_t  write(unsigned int Data)  { return write((uint8_t) Data); }
+    size_t  write(long Data)          { return write((uint8_t) Data); }
+    size_t  write(unsigned long Data) { return write((uint8_t) Data); }
+
+    int     available()               { return rxLength - rxPosition; }
+    int     read()                    { return rxPosition < rxLength ? rxBuffer[rxPosition++] : -1; }
+
+    // Transactions addressed to each device through this bus, and calls to begin()
+    unsigned long rtcTransactions    = 0;
+    unsigned long eepromTransactions = 0;
+    unsigned long begins             = 0;
+
+    // Begun and not ended, the I2C hardware has SDA and SCL
+    uint8_t       enabled            = 0;
+
+  protected:
+    uint8_t txAddress  = 0;
+    uint8_t txBuffer[BUFFER_LENGTH];
+    uint8_t txLength   = 0;
+    uint8_t rxBuffer[BUFFER_LENGTH];
+    uint8_t rxLength   = 0;
+    uint8_t rxPosition = 0;
+};
+
+// Both buses reach the same simulated devices
+extern TwoWire Wire;
+extern TwoWire Wire1;
+
+#endif
@@ -0,0 +1,95 @@
+// USE_SELECTABLE_WIRE: with setWire() the clock's traffic goes only to its bus and the
+// EEPROM's only to its bus, at the address it was given, and begin() starts each bus
+// once.
+
+#include "DS3231_Simple.h"
+#include "HostTest.h"
+
+#ifndef USE_SELECTABLE_WIRE
+  #error "Build with -DUSE_SELECTABLE_WIRE"
+#endif
+
+static void resetWire(TwoWire &Bus)
+{
+  Bus.rtcTransactions    = 0;
+  Bus.eepromTransactions = 0;
+  Bus.begins             = 0;
+}
+
+int main()
+{
+  DateTime Now;
+  DateTime Logged;
+  uint16_t Data;
+
+  // The clock on Wire1, the EEPROM at 0x50 on Wire
+  {
+    sim.eepromAddress = 0x50;
+    resetWire(Wire);
+    resetWire(Wire1);
+
+    DS3231_Simple Clock;
+    Clock.setWire(Wire1, Wire, 0x50);
+    CHECK(Clock.begin());
+    CHECK(Wire1.begins == 1 && Wire.begins == 1);
+
+    CHECK(Clock.read(Now));
+    CHECK(Clock.formatEEPROM(DS3231_Simple::FORMAT_FAST));
+    for(uint16_t x = 0; x < 300; x++)
+    {
+      DS3231_Simple::addSeconds(Now, 1);
+      CHECK(Clock.writeLog(Now, x));
+    }
+    for(uint16_t x = 0; x < 300; x++)
+    {
+      if(!Clock.readLog(Logged, Data) || Data != x) { CHECK(0); break; }
+    }
+    CHECK(!Clock.readLog(Logged, Data));
+
+    CHECK(Wire1.rtcTransactions && !Wire1.eepromTransactions);
+    CHECK(Wire.eepromTransactions && !Wire.rtcTransactions);
+  }
+
+  // At an address with no EEPROM the log fails, the clock still works
+  {
+    DS3231_Simple Clock;
+    Clock.setWire(Wire1, Wire, 0x51);
+    CHECK(Clock.begin());
+    CHECK(Clock.read(Now));
+    CHECK(!Clock.writeLog(Now, 1));
+    CHECK(Clock.getLastError());
+  }
+
+  // Both on one bus, begun once
+  {
+    sim.eepromAddress = DS3231_EEPROM_ADDRESS;
+    resetWire(Wire);
+    resetWire(Wire1);
+
+    DS3231_Simple Clock;
+    Clock.setWire(Wire1, Wire1);
+    CHECK(Clock.begin());
+    CHECK(Wire1.begins == 1 && !Wire.begins);
+    CHECK(Clock.read(Now));
+    CHECK(Clock.writeLog(Now, 1));
+    CHECK(Clock.readLog(Logged, Data) && Data == 1);
+    CHECK(Wire1.rtcTransactions && Wire1.eepromTransactions);
+    CHECK(!Wire.rtcTransactions && !Wire.eepromTransactions);
+  }
+
+  // Without setWire() it is Wire and the usual address
+  {
+    resetWire(Wire);
+    resetWire(Wire1);
+
+    DS3231_Simple Clock;
+    CHECK(Clock.begin());
+    CHECK(Clock.read(Now));
+    CHECK(Clock.writeLog(Now, 2));
+    CHECK(Wire.begins == 1 && Wire.rtcTransactions && Wire.eepromTransactions);
+    CHECK(!Wire1.begins && !Wire1.rtcTransactions && !Wire1.eepromTransactions);
+  }
+
+  CHECK(!sim.overflows);
+  return failures;
+}